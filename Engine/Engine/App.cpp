@@ -1,10 +1,16 @@
 #include "App.h"
 
+#include <algorithm>
+
 App* app = nullptr;
 
 App::App(int argc, char* argv[])
 {
 	app = this;
+	startupBegin = Timer::NowNs();
+
+	headlessRunner.ParseArguments(argc, argv);
+	const bool withEditor = !headlessRunner.IsEnabled();
 
 	window = new ModuleWindow(this);
 	camera = new ModuleCamera(this);
@@ -15,17 +21,27 @@ App::App(int argc, char* argv[])
 	editor = new ModuleEditor(this);
 	fileSystem = new ModuleFileSystem(this);
 	resources = new ModuleResources(this);
+	debugDraw = new ModuleDebugDraw(this);
 
-	AddModule(window);
-	AddModule(camera);
-	AddModule(input);
+	// Headless runs keep every module object alive, other modules point at them,
+	// but the ones tied to the window or the editor are never initialized nor updated
+	AddModule(window, withEditor);
+	AddModule(camera, withEditor);
+	AddModule(input, withEditor);
 	AddModule(fileSystem);
 	AddModule(resources);
 	AddModule(importer);
 	AddModule(scene);
-	AddModule(editor);
+	AddModule(editor, withEditor);
+	AddModule(debugDraw);
 	AddModule(renderer3D);
 
+	if (headlessRunner.IsEnabled())
+	{
+		idleThrottling = false;
+		time.lockstep = true;
+	}
+
 	window->loadingBarWidth = static_cast<int>(335 / (modules.size() * 2));
 }
 
@@ -43,13 +59,47 @@ bool App::Awake()
 {
 	bool ret = true;
 
-	for (const auto& module : modules)
+	jobs.Start(jobWorkerCount);
+
+	SortInitOrder();
+
+	// Thread-safe init work of every module starts right away, the main thread only
+	// waits for a module's part before awaking that module
+	std::vector<JobCounter> asyncCounters(initOrder.size());
+	std::vector<char> asyncResults(initOrder.size(), 1);
+
+	for (size_t i = 0; i < initOrder.size(); ++i)
 	{
+		Module* module = initOrder[i];
 		if (!module->active)
 			continue;
 
-		ret = module->Awake();
-		window->RenderInitialScreen();
+		jobs.Submit([this, module, &asyncResults, i]()
+			{
+				const int64_t start = Timer::NowNs();
+				asyncResults[i] = module->AwakeAsync();
+				RecordStartup(module->name, "AwakeAsync", start, false);
+			}, &asyncCounters[i]);
+	}
+
+	for (size_t i = 0; i < initOrder.size(); ++i)
+	{
+		Module* module = initOrder[i];
+		if (!module->active)
+			continue;
+
+		jobs.Wait(asyncCounters[i]);
+
+		const int64_t start = Timer::NowNs();
+		if (!asyncResults[i] || !module->Awake())
+		{
+			LOG(LogType::LOG_ERROR, "%s failed to awake", module->name);
+			ret = false;
+		}
+		RecordStartup(module->name, "Awake", start, true);
+
+		if (window->active)
+			window->RenderInitialScreen();
 	}
 
 	timer.Start();
@@ -61,24 +111,99 @@ bool App::Start()
 {
 	bool ret = true;
 
-	for (const auto& module : modules)
+	for (const auto& module : initOrder)
 	{
 		if (!module->active)
 			continue;
 
+		const int64_t start = Timer::NowNs();
 		ret = module->Start();
-		window->RenderInitialScreen();
+		RecordStartup(module->name, "Start", start, true);
+
+		if (window->active)
+			window->RenderInitialScreen();
 	}
 
-	ret = window->StartWindow();
+	if (window->active)
+		ret = window->StartWindow();
+	else
+		time.Play();
+
+	LogStartupTimeline();
 
 	return ret;
 }
 
+void App::SortInitOrder()
+{
+	// Kahn's algorithm, ties are broken by the order modules were added in
+	initOrder.clear();
+	std::vector<Module*> remaining(modules.begin(), modules.end());
+
+	while (!remaining.empty())
+	{
+		auto ready = std::find_if(remaining.begin(), remaining.end(), [this](const Module* module)
+			{
+				for (const Module* dependency : module->GetDependencies())
+				{
+					if (std::find(initOrder.begin(), initOrder.end(), dependency) == initOrder.end())
+						return false;
+				}
+				return true;
+			});
+
+		if (ready == remaining.end())
+		{
+			LOG(LogType::LOG_ERROR, "Module dependencies form a cycle, %s and the rest are initialized in list order", remaining.front()->name);
+			initOrder.insert(initOrder.end(), remaining.begin(), remaining.end());
+			break;
+		}
+
+		initOrder.push_back(*ready);
+		remaining.erase(ready);
+	}
+}
+
+void App::RecordStartup(const char* module, const char* phase, int64_t start, bool mainThread)
+{
+	const int64_t end = Timer::NowNs();
+
+	std::lock_guard<std::mutex> lock(startupMutex);
+	startupTimeline.push_back({ module, phase, start - startupBegin, end - startupBegin, mainThread });
+}
+
+void App::LogStartupTimeline()
+{
+	std::lock_guard<std::mutex> lock(startupMutex);
+
+	std::sort(startupTimeline.begin(), startupTimeline.end(), [](const StartupEntry& a, const StartupEntry& b) { return a.startNs < b.startNs; });
+
+	for (const StartupEntry& entry : startupTimeline)
+	{
+		LOG(LogType::LOG_INFO, "Startup %8.2f - %8.2f ms  %-11s %-10s %s", entry.startNs / 1000000.0, entry.endNs / 1000000.0,
+			entry.module, entry.phase, entry.mainThread ? "main" : "worker");
+	}
+
+	LOG(LogType::LOG_INFO, "Startup finished in %.2f ms", (Timer::NowNs() - startupBegin) / 1000000.0);
+}
+
 void App::PrepareUpdate()
 {
-	dt = timer.ReadMs() / 1000.0f;
+	dt = static_cast<float>(timer.ReadNs() / 1000000000.0);
 	timer.Start();
+
+	if (headlessRunner.IsEnabled())
+		headlessRunner.BeginFrame();
+
+	// Nothing is submitting between frames once the background steps are back: the
+	// render thread never does and the modules only wait on jobs inside their phases
+	if (pendingWorkerCount > 0)
+	{
+		tasks.WaitInFlight();
+		jobWorkerCount = pendingWorkerCount;
+		pendingWorkerCount = 0;
+		jobs.Start(jobWorkerCount);
+	}
 }
 
 bool App::Update()
@@ -87,75 +212,93 @@ bool App::Update()
 
 	PrepareUpdate();
 
+	if (jobs.RunMainThreadJobs() > 0)
+		RequestRedraw();
+
 	if (ret)
-	{
-		for (const auto& module : modules)
-		{
-			if (!module->active)
-				continue;
+		ret = UpdateModules(&Module::PreUpdate);
 
-			ret = module->PreUpdate(dt);
+	if (ret)
+		ret = UpdateModules(&Module::Update);
 
-			if (!ret)
-				break;
-		}
-	}
+	// Between Update and PostUpdate so finished work shows up in this frame's render
+	tasks.Update();
+	if (tasks.HasTasks())
+		RequestRedraw();
 
 	if (ret)
-	{
-		for (const auto& module : modules)
-		{
-			if (!module->active)
-				continue;
+		ret = UpdateModules(&Module::PostUpdate);
 
-			ret = module->Update(dt);
+	FinishUpdate();
 
-			if (!ret)
-				break;
-		}
-	}
+	return ret;
+}
 
-	if (ret)
+bool App::UpdateModules(bool (Module::*phase)(float))
+{
+	const bool headless = headlessRunner.IsEnabled();
+
+	for (const auto& module : modules)
 	{
-		for (const auto& module : modules)
-		{
-			if (!module->active)
-				continue;
+		if (!module->active)
+			continue;
 
-			ret = module->PostUpdate(dt);
+		const int64_t start = headless ? Timer::NowNs() : 0;
+		const bool ret = (module->*phase)(dt);
 
-			if (!ret)
-				break;
-		}
-	}
+		if (headless)
+			headlessRunner.RecordModule(module, Timer::NowNs() - start);
 
-	FinishUpdate();
+		if (!ret)
+			return false;
+	}
 
-	return ret;
+	return true;
 }
 
 void App::FinishUpdate()
 {
-	if (!vsync)
-	{
-		const float frameDelay = 1000.0f / maxFps;
+	if (redrawFrames > 0)
+		redrawFrames--;
 
-		float frameTime = timer.ReadMs();
+	if (IsIdle())
+	{
+		SDL_WaitEventTimeout(nullptr, 1000 / (std::max)(idleRefreshRate, 1));
 
-		if (frameTime < frameDelay)
-			SDL_Delay((Uint32)(frameDelay - frameTime));
+		// The time spent waiting is not part of the next frame
+		timer.Start();
+		pacer.Restart();
+	}
+	else
+	{
+		pacer.EndFrame(vsync || headlessRunner.IsEnabled() ? 0 : maxFps);
 	}
 
 	time.Update();
+	jobs.SampleUtilization();
+
+	if (headlessRunner.IsEnabled())
+	{
+		const ComponentCamera* gameCamera = scene->activeGameCamera;
+		if (headlessRunner.EndFrame(gameCamera != nullptr ? static_cast<uint32_t>(gameCamera->meshCount) : 0))
+			exit = true;
+	}
 }
 
 bool App::CleanUp()
 {
 	bool ret = true;
 
+	if (headlessRunner.IsEnabled())
+		headlessRunner.PrintReport();
+
+	tasks.Clear();
+	jobs.Stop();
+
 	for (auto it = modules.rbegin(); it != modules.rend(); ++it)
 	{
-		ret = (*it)->CleanUp();
+		if ((*it)->active)
+			ret = (*it)->CleanUp();
 	}
 
 	return ret;
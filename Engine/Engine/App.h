@@ -10,11 +10,19 @@
 #include "ModuleImporter.h"
 #include "ModuleFileSystem.h"
 #include "ModuleResources.h"
+#include "ModuleDebugDraw.h"
 #include "Time.h"
+#include "JobSystem.h"
+#include "FramePacer.h"
+#include "TaskScheduler.h"
+#include "HeadlessRunner.h"
 
 #include "Timer.h"
 
+#include <cstdint>
 #include <list>
+#include <mutex>
+#include <vector>
 
 class App
 {
@@ -29,11 +37,28 @@ public:
 
 	float GetDT() { return dt; }
 
+	// Keeps the editor rendering at full rate for a few frames. Without requests the
+	// loop sleeps on SDL events and the scene framebuffers are not redrawn.
+	void RequestRedraw() { redrawFrames = IDLE_SETTLE_FRAMES; }
+	bool IsIdle() const { return idleThrottling && redrawFrames == 0; }
+
+	bool IsHeadless() const { return headlessRunner.IsEnabled(); }
+
+	// Restarts the job system with another worker count at the start of the next frame
+	void RequestWorkerCount(int count) { pendingWorkerCount = count; }
+
 private:
 	void AddModule(Module* module, bool enable = true);
 
 	void PrepareUpdate();
 	void FinishUpdate();
+	bool UpdateModules(bool (Module::*phase)(float));
+
+	// Dependencies first, the update order is still the order modules were added in
+	void SortInitOrder();
+
+	void RecordStartup(const char* module, const char* phase, int64_t start, bool mainThread);
+	void LogStartupTimeline();
 
 public:
 	ModuleWindow* window = nullptr;
@@ -45,18 +70,46 @@ public:
 	ModuleEditor* editor = nullptr;
 	ModuleFileSystem* fileSystem = nullptr;
 	ModuleResources* resources = nullptr;
+	ModuleDebugDraw* debugDraw = nullptr;
 
 	bool exit = false;
 	int maxFps = 60;
 	bool vsync = true;
+	int jobWorkerCount = 0;
+
+	bool idleThrottling = true;
+	int idleRefreshRate = 4;
 
 	Time time;
+	JobSystem jobs;
+	FramePacer pacer;
+	TaskScheduler tasks;
+	HeadlessRunner headlessRunner;
 
 private:
+	// ImGui needs a couple of frames after an event to settle hover and layout
+	static const int IDLE_SETTLE_FRAMES = 3;
+
 	Timer	timer;
 	float	dt;
+	int		redrawFrames = IDLE_SETTLE_FRAMES;
+	int		pendingWorkerCount = 0;
 
 	std::list<Module*> modules;
+	std::vector<Module*> initOrder;
+
+	struct StartupEntry
+	{
+		const char* module;
+		const char* phase;
+		int64_t startNs;
+		int64_t endNs;
+		bool mainThread;
+	};
+
+	int64_t startupBegin = 0;
+	std::mutex startupMutex;
+	std::vector<StartupEntry> startupTimeline;
 };
 
 extern App* app;
\ No newline at end of file
@@ -27,6 +27,10 @@ public:
 	virtual void Update();
 	virtual void OnEditor();
 
+	// Scripts that only touch their own object can opt in to the parallel update pass,
+	// the rest run on the main thread after it
+	virtual bool IsThreadSafe() const { return false; }
+
 	virtual void Serialize(nlohmann::json& json) const;
 	virtual void Deserialize(const nlohmann::json& json);
 
@@ -31,10 +31,6 @@ void ComponentCamera::Update()
 		frustumNeedsUpdate = false;
 	}
 
-	meshCount = 0;
-	vertexCount = 0;
-	triangleCount = 0;
-
 	if (gameObject)
 	{
 		position = gameObject->transform->position;
@@ -77,7 +73,8 @@ void ComponentCamera::CalculateViewMatrix()
 
 glm::mat4 ComponentCamera::GetProjectionMatrix() const
 {
-	float aspectRatio = app->editor->sceneWindow->windowSize.x / app->editor->sceneWindow->windowSize.y;
+	// Set from the viewport by ModuleRenderer3D, editor windows do not exist in headless runs
+	const float aspectRatio = screenHeight > 0 ? static_cast<float>(screenWidth) / static_cast<float>(screenHeight) : 1.0f;
 	return glm::perspective(glm::radians(fov), aspectRatio, nearPlane, farPlane);
 }
 
@@ -105,7 +102,16 @@ void ComponentCamera::CalculateFrustumPlanes()
 		frustumPlanes[i].distance /= length;
 	}
 
+	visibilityNeedsUpdate = true;
+}
+
+void ComponentCamera::UpdateVisibility()
+{
+	if (!visibilityNeedsUpdate)
+		return;
+
 	app->scene->sceneOctree->UpdateAllNodesVisibility(this);
+	visibilityNeedsUpdate = false;
 }
 
 bool ComponentCamera::IsAABBInFrustum(const AABB& aabb) const
@@ -4,6 +4,7 @@
 #include <glm/fwd.hpp>
 
 #include "Component.h"
+#include "ComponentStorage.h"
 #include "Mesh.h"
 
 struct Plane
@@ -18,6 +19,9 @@ public:
 	ComponentCamera(GameObject* owner);
 	~ComponentCamera();
 
+	static void* operator new(size_t size) { return ComponentPool<ComponentCamera>::Get().Allocate(size); }
+	static void operator delete(void* ptr, size_t size) { ComponentPool<ComponentCamera>::Get().Free(ptr, size); }
+
 	void Update() override;
 	void OnEditor() override;
 
@@ -28,6 +32,10 @@ public:
 	glm::mat4 GetProjectionMatrix() const;
 
 	bool IsAABBInFrustum(const AABB& aabb) const;
+	const Plane* GetFrustumPlanes() const { return frustumPlanes; }
+
+	// Octree visibility pass, run by the renderer for every camera in parallel
+	void UpdateVisibility();
 
 	void CalculateViewMatrix();
 
@@ -41,10 +49,13 @@ public:
 	int screenWidth, screenHeight;
 
 	bool frustumNeedsUpdate = true;
+	bool visibilityNeedsUpdate = true;
 
 	int meshCount = 0;
 	int vertexCount = 0;
 	int triangleCount = 0;
+	int clusterCount = 0;
+	int visibleClusterCount = 0;
 
 	glm::vec3 X, Y, Z;
 	glm::vec3 position, reference;
@@ -25,7 +25,7 @@ void ComponentMaterial::OnEditor()
 {
 	if (ImGui::CollapsingHeader("Material", ImGuiTreeNodeFlags_DefaultOpen))
 	{
-		if (materialTexture->textureId != -1)
+		if (materialTexture != nullptr && materialTexture->textureId != -1)
 		{
 			ImGui::Text("Path: %s", materialTexture->texturePath);
 			ImGui::Text("Texture Size: %i x %i", materialTexture->textureWidth, materialTexture->textureHeight);
@@ -50,40 +50,25 @@ void ComponentMaterial::OnEditor()
 			if (ImGui::Checkbox("Show Checkers Texture", &showCheckersTexture))
 			{
 				textureId = showCheckersTexture ? app->renderer3D->checkerTextureId : materialTexture->textureId;
+				app->scene->sceneEvents.Record(SceneEventType::STATE_CHANGED, gameObject);
 			}
 
-			ImGui::ColorEdit4("Material Color", &gameObject->mesh->mesh->diffuseColor[0]);
+			if (gameObject->mesh != nullptr && gameObject->mesh->mesh != nullptr)
+			{
+				if (ImGui::ColorEdit4("Material Color", &gameObject->mesh->mesh->diffuseColor[0]))
+					app->scene->sceneEvents.Record(SceneEventType::STATE_CHANGED, gameObject);
+			}
 		}
 	}
 }
 
-void ComponentMaterial::AddTexture(Texture* texture)
+void ComponentMaterial::SetTexture(Texture* texture)
 {
-	if (gameObject->GetComponent(ComponentType::MESH))
-	{
-		if (!gameObject->GetComponent(ComponentType::MATERIAL))
-		{
-			gameObject->AddComponent(gameObject->material);
-		}
-
-		app->resources->ModifyResourceUsageCount(materialTexture, -1);
-		app->resources->ModifyResourceUsageCount(texture, 1);
-		materialTexture = texture;
-		textureId = materialTexture->textureId;
-	}
-
-	for (auto& child : gameObject->children)
-	{
-		if (!child->GetComponent(ComponentType::MATERIAL))
-		{
-			child->AddComponent(child->material);
-		}
-
-		app->resources->ModifyResourceUsageCount(child->material->materialTexture, -1);
-		app->resources->ModifyResourceUsageCount(texture, 1);
-		child->material->materialTexture = texture;
-		child->material->textureId = texture->textureId;
-	}
+	app->resources->ModifyResourceUsageCount(materialTexture, -1);
+	app->resources->ModifyResourceUsageCount(texture, 1);
+	materialTexture = texture;
+	textureId = materialTexture->textureId;
+	app->scene->sceneEvents.Record(SceneEventType::STATE_CHANGED, gameObject);
 }
 
 void ComponentMaterial::Serialize(nlohmann::json& json) const
@@ -98,6 +83,8 @@ void ComponentMaterial::Deserialize(const nlohmann::json& json)
 	std::string texturePath = json["texture"].get<std::string>();
 	if (!texturePath.empty())
 	{
-		AddTexture(dynamic_cast<Texture*>(app->resources->FindResourceInLibrary(texturePath, ResourceType::TEXTURE)));
+		Texture* texture = dynamic_cast<Texture*>(app->resources->FindResourceInLibrary(texturePath, ResourceType::TEXTURE));
+		if (texture != nullptr)
+			SetTexture(texture);
 	}
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Component.h"
+#include "ComponentStorage.h"
 #include "Texture.h"
 
 class ComponentMaterial : public Component
@@ -9,13 +10,16 @@ public:
 	ComponentMaterial(GameObject* gameObject);
 	virtual ~ComponentMaterial();
 
+	static void* operator new(size_t size) { return ComponentPool<ComponentMaterial>::Get().Allocate(size); }
+	static void operator delete(void* ptr, size_t size) { ComponentPool<ComponentMaterial>::Get().Free(ptr, size); }
+
 	void Update() override;
 	void OnEditor() override;
 
 	void Serialize(nlohmann::json& json) const override;
 	void Deserialize(const nlohmann::json& json) override;
 
-	void AddTexture(Texture* texture);
+	void SetTexture(Texture* texture);
 
 public:
 	Texture* materialTexture;
@@ -1,8 +1,6 @@
 #include "ComponentMesh.h"
 #include "App.h"
 
-#include <glm/gtc/type_ptr.hpp>
-
 ComponentMesh::ComponentMesh(GameObject* gameObject) : Component(gameObject, ComponentType::MESH), mesh(nullptr)
 {
 }
@@ -13,92 +11,140 @@ ComponentMesh::~ComponentMesh()
 	mesh = nullptr;
 }
 
-void ComponentMesh::Update()
+void ComponentMesh::Submit(ComponentCamera* camera, RenderView& view, bool decorationsOnly)
 {
-    if (gameObject->transform != nullptr)
-    {
-        app->renderer3D->meshQueue.push_back(this);
-    }
+	ComponentTransform* transform = gameObject->transform;
+	ComponentMaterial* material = gameObject->material;
+
+	if (transform == nullptr || mesh == nullptr)
+		return;
+
+	const glm::mat4 worldTransform = transform->GetInterpolatedTransform(app->time.GetInterpolationAlpha());
+
+	const AABB meshAABB = mesh->GetAABB(worldTransform);
+	if (!camera->IsAABBInFrustum(meshAABB))
+		return;
+
+	RenderItem item;
+	item.mesh = mesh;
+	item.textureId = material != nullptr ? material->textureId : 0;
+	item.transform = worldTransform;
+
+	if (view.editorView)
+	{
+		const bool selected = app->editor->selectedGameObject == gameObject;
+
+		item.drawOutline = drawOutline;
+		item.parentSelected = gameObject->isParentSelected;
+		item.vertexNormals = showVertexNormals;
+		item.faceNormals = showFaceNormals;
+		item.drawAABB = selected && showAABB;
+		item.drawOBB = selected && showOBB;
+	}
+
+	item.decorationsOnly = decorationsOnly;
+	if (decorationsOnly && !item.HasDecorations())
+		return;
+
+	const glm::vec3 center = (meshAABB.min + meshAABB.max) * 0.5f;
+	const float depth = -(view.view * glm::vec4(center, 1.0f)).z;
+
+	// Radius of the bounds in pixels, each view keeps its own level for the hysteresis
+	const float radius = glm::length(meshAABB.max - meshAABB.min) * 0.5f;
+	const float screenRadius = radius * view.projection[1][1] * view.height * 0.5f / glm::max(depth, 0.001f);
+	uint& lod = viewLods[view.editorView ? 0 : 1];
+	lod = mesh->SelectLod(screenRadius, lod);
+	item.lod = lod;
+
+	uint drawnIndices = mesh->GetLodIndexCount(lod);
+	if (lod == 0 && mesh->meshlets.size() > 1 && !decorationsOnly)
+	{
+		drawnIndices = CullMeshlets(camera, view, worldTransform, item);
+		if (drawnIndices == 0)
+		{
+			if (!item.HasDecorations())
+				return;
+			item.decorationsOnly = true;
+		}
+	}
+
+	if (!item.decorationsOnly)
+	{
+		camera->meshCount++;
+		camera->vertexCount += mesh->verticesCount;
+		camera->triangleCount += drawnIndices / 3;
+	}
+
+	item.sortKey = MakeSortKey(item.drawOutline ? RenderPass::OUTLINED : RenderPass::GEOMETRY, item.textureId, mesh, lod, depth);
+
+	view.items.push_back(item);
 }
 
-void ComponentMesh::Draw(ComponentCamera* camera)
+uint ComponentMesh::CullMeshlets(ComponentCamera* camera, RenderView& view, const glm::mat4& worldTransform, RenderItem& item) const
 {
-    ComponentTransform* transform = gameObject->transform;
-    ComponentMaterial* material = gameObject->material;
-
-    if (transform != nullptr)
-    {
-        const AABB meshAABB = mesh->GetAABB(transform->globalTransform);
-
-        if (camera->IsAABBInFrustum(meshAABB))
-        {
-            camera->meshCount++;
-            camera->vertexCount += mesh->verticesCount;
-            camera->triangleCount += mesh->indicesCount / 3;
-
-            glPushMatrix();
-            glMultMatrixf(glm::value_ptr(transform->globalTransform));
-
-            const auto& preferences = app->editor->preferencesWindow;
-
-            if (camera == app->scene->sceneCamera)
-            {
-                mesh->DrawMesh(
-                    material->textureId,
-                    preferences->drawTextures,
-                    preferences->wireframe,
-                    preferences->shadedWireframe
-                );
-
-                if (drawOutline)
-                    mesh->DrawOutline(gameObject->isParentSelected);
-
-                if (showVertexNormals || showFaceNormals)
-                {
-                    mesh->DrawNormals(
-                        showVertexNormals,
-                        showFaceNormals,
-                        preferences->vertexNormalLength,
-                        preferences->faceNormalLength,
-                        preferences->vertexNormalColor,
-                        preferences->faceNormalColor
-                    );
-                }
-
-                glPopMatrix();
-
-                if (app->editor->selectedGameObject == gameObject)
-                {
-                    if (showAABB)
-                        mesh->DrawAABB(transform->globalTransform);
-                    if (showOBB)
-                        mesh->DrawOBB(transform->globalTransform);
-                }
-            }
-            else
-            {
-                mesh->DrawMesh(
-                    material->textureId,
-                    preferences->drawTextures,
-                    false,
-                    false
-                );
-
-                glPopMatrix();
-            }
-
-        }
-    }
+	// The frustum and the camera are moved into the mesh space, where the meshlet bounds are
+	const glm::mat4 transposed = glm::transpose(worldTransform);
+	const Plane* frustumPlanes = camera->GetFrustumPlanes();
+
+	glm::vec4 planes[6];
+	for (int i = 0; i < 6; ++i)
+	{
+		planes[i] = transposed * glm::vec4(frustumPlanes[i].normal, frustumPlanes[i].distance);
+		planes[i] /= glm::length(glm::vec3(planes[i]));
+	}
+
+	const glm::vec3 localCamera = glm::vec3(glm::inverse(worldTransform) * glm::vec4(view.cameraPosition, 1.0f));
+
+	// Normal cones do not survive non-uniform scaling, and a mirroring transform flips the
+	// winding so the faces the cones point away from are the ones drawn
+	const float scaleX = glm::length(glm::vec3(worldTransform[0]));
+	const float scaleY = glm::length(glm::vec3(worldTransform[1]));
+	const float scaleZ = glm::length(glm::vec3(worldTransform[2]));
+	const bool uniformScale = glm::abs(scaleX - scaleY) <= scaleX * 0.01f && glm::abs(scaleX - scaleZ) <= scaleX * 0.01f;
+	const bool mirrored = glm::determinant(glm::mat3(worldTransform)) <= 0.0f;
+
+	const bool coneCulling = view.cullBackfaces && uniformScale && !mirrored;
+	const uint32_t visibleCount = Meshlets::Cull(mesh->meshletBounds, planes, localCamera, coneCulling, view.meshletVisibility);
+
+	camera->clusterCount += static_cast<int>(mesh->meshlets.size());
+	camera->visibleClusterCount += static_cast<int>(visibleCount);
+
+	if (visibleCount == mesh->meshlets.size())
+		return mesh->indicesCount;
+
+	// Neighbouring survivors are merged, they are contiguous in the index buffer
+	std::vector<IndexRange>& ranges = view.commands.indexRanges;
+	item.firstRange = static_cast<uint32_t>(ranges.size());
+
+	uint drawnIndices = 0;
+	for (size_t i = 0; i < mesh->meshlets.size(); ++i)
+	{
+		if (!view.meshletVisibility[i])
+			continue;
+
+		const Meshlet& meshlet = mesh->meshlets[i];
+		if (ranges.size() > item.firstRange && ranges.back().firstIndex + ranges.back().indexCount == meshlet.firstIndex)
+			ranges.back().indexCount += meshlet.indexCount;
+		else
+			ranges.push_back({ meshlet.firstIndex, meshlet.indexCount });
+
+		drawnIndices += meshlet.indexCount;
+	}
+
+	item.rangeCount = static_cast<uint32_t>(ranges.size()) - item.firstRange;
+	return drawnIndices;
 }
 
 void ComponentMesh::OnEditor()
 {
-	if (ImGui::CollapsingHeader("Mesh Renderer", ImGuiTreeNodeFlags_DefaultOpen))
+	if (mesh != nullptr && ImGui::CollapsingHeader("Mesh Renderer", ImGuiTreeNodeFlags_DefaultOpen))
 	{
 		ImGui::Text("Vertices: %d", mesh->verticesCount);
 		ImGui::Text("Indices: %d", mesh->indicesCount);
 		ImGui::Text("Normals: %d", mesh->normalsCount);
 		ImGui::Text("Texture Coords: %d", mesh->texCoordsCount);
+		ImGui::Text("LODs: %d", mesh->GetLodCount());
+		ImGui::Text("Meshlets: %d", static_cast<int>(mesh->meshlets.size()));
 
 		ImGui::Spacing();
 
@@ -115,7 +161,7 @@ void ComponentMesh::OnEditor()
 void ComponentMesh::Serialize(nlohmann::json& json) const
 {
 	Component::Serialize(json);
-	json["mesh"] = mesh->GetLibraryFileDir();
+	json["mesh"] = mesh ? mesh->GetLibraryFileDir() : "";
 }
 
 void ComponentMesh::Deserialize(const nlohmann::json& json)
@@ -1,8 +1,10 @@
 #pragma once
 
 #include "Component.h"
+#include "ComponentStorage.h"
 #include "ComponentCamera.h"
 #include "Mesh.h"
+#include "RenderSnapshot.h"
 
 class Mesh;
 
@@ -12,17 +14,24 @@ public:
 	ComponentMesh(GameObject* gameObject);
 	virtual ~ComponentMesh();
 
-	void Update() override;
+	static void* operator new(size_t size) { return ComponentPool<ComponentMesh>::Get().Allocate(size); }
+	static void operator delete(void* ptr, size_t size) { ComponentPool<ComponentMesh>::Get().Free(ptr, size); }
+
 	void OnEditor() override;
 
 	void Serialize(nlohmann::json& json) const override;
 	void Deserialize(const nlohmann::json& json) override;
 
-	void Draw(ComponentCamera* camera);
+	void Submit(ComponentCamera* camera, RenderView& view, bool decorationsOnly = false);
 
 public:
 	Mesh* mesh;
 	bool drawOutline = false;
+	bool inActiveHierarchy = true;
+
+private:
+	// Returns the indices left to draw, visible meshlets become index ranges of the item
+	uint CullMeshlets(ComponentCamera* camera, RenderView& view, const glm::mat4& worldTransform, RenderItem& item) const;
 
 private:
 	bool showVertexNormals = false;
@@ -30,4 +39,7 @@ private:
 
 	bool showAABB = false;
 	bool showOBB = false;
+
+	// Level drawn last frame by the scene and game views
+	uint viewLods[2] = { 0, 0 };
 };
\ No newline at end of file
@@ -35,6 +35,10 @@ void ComponentScript::Reset()
 	gameObject->transform->UpdateTransform();
 }
 
+void ComponentScript::FixedUpdate()
+{
+}
+
 void ComponentScript::Update()
 {
 }
@@ -19,6 +19,9 @@ public:
     virtual void Start();
     virtual void Reset();
 
+    // Runs at Time's tick rate, zero or more times per frame, before Update
+    virtual void FixedUpdate();
+
 	void Update() override;
 	void OnEditor() override;
 
@@ -0,0 +1,108 @@
+#include "ComponentStorage.h"
+
+#include "GameObject.h"
+
+ComponentStorage::ComponentStorage()
+{
+}
+
+ComponentStorage::~ComponentStorage()
+{
+	archetypeBySignature.clear();
+	archetypes.clear();
+}
+
+void ComponentStorage::UpdateArchetype(GameObject* gameObject)
+{
+	ComponentSignature signature = 0;
+	for (const Component* component : gameObject->components)
+		signature |= SignatureOf(component->type);
+
+	if (gameObject->archetype != nullptr && gameObject->archetype->signature == signature)
+	{
+		FillRow(*gameObject->archetype, gameObject->archetypeRow, gameObject);
+		return;
+	}
+
+	RemoveFromArchetype(gameObject);
+
+	Archetype& archetype = GetOrCreateArchetype(signature);
+
+	gameObject->signature = signature;
+	gameObject->archetype = &archetype;
+	gameObject->archetypeRow = archetype.gameObjects.size();
+
+	archetype.gameObjects.push_back(gameObject);
+	for (size_t type = 0; type < COMPONENT_TYPE_COUNT; ++type)
+	{
+		if (archetype.Has(static_cast<ComponentType>(type)))
+			archetype.columns[type].push_back(nullptr);
+	}
+
+	FillRow(archetype, gameObject->archetypeRow, gameObject);
+}
+
+void ComponentStorage::RemoveFromArchetype(GameObject* gameObject)
+{
+	Archetype* archetype = gameObject->archetype;
+	if (archetype == nullptr)
+		return;
+
+	const size_t row = gameObject->archetypeRow;
+	const size_t last = archetype->gameObjects.size() - 1;
+
+	// Swap with the last row so every column stays packed
+	if (row != last)
+	{
+		GameObject* moved = archetype->gameObjects[last];
+		archetype->gameObjects[row] = moved;
+		moved->archetypeRow = row;
+
+		for (size_t type = 0; type < COMPONENT_TYPE_COUNT; ++type)
+		{
+			if (archetype->Has(static_cast<ComponentType>(type)))
+				archetype->columns[type][row] = archetype->columns[type][last];
+		}
+	}
+
+	archetype->gameObjects.pop_back();
+	for (size_t type = 0; type < COMPONENT_TYPE_COUNT; ++type)
+	{
+		if (archetype->Has(static_cast<ComponentType>(type)))
+			archetype->columns[type].pop_back();
+	}
+
+	gameObject->archetype = nullptr;
+	gameObject->archetypeRow = 0;
+	gameObject->signature = 0;
+}
+
+Archetype& ComponentStorage::GetOrCreateArchetype(ComponentSignature signature)
+{
+	auto it = archetypeBySignature.find(signature);
+	if (it != archetypeBySignature.end())
+		return *it->second;
+
+	archetypes.push_back(std::make_unique<Archetype>());
+	Archetype* archetype = archetypes.back().get();
+	archetype->signature = signature;
+	archetypeBySignature[signature] = archetype;
+
+	return *archetype;
+}
+
+void ComponentStorage::FillRow(Archetype& archetype, size_t row, const GameObject* gameObject) const
+{
+	for (size_t type = 0; type < COMPONENT_TYPE_COUNT; ++type)
+	{
+		if (archetype.Has(static_cast<ComponentType>(type)))
+			archetype.columns[type][row] = nullptr;
+	}
+
+	for (Component* component : gameObject->components)
+	{
+		std::vector<Component*>& column = archetype.Column(component->type);
+		if (column[row] == nullptr)
+			column[row] = component;
+	}
+}
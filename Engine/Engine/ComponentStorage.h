@@ -0,0 +1,126 @@
+#pragma once
+
+#include "Component.h"
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <unordered_map>
+#include <vector>
+
+class GameObject;
+
+typedef uint32_t ComponentSignature;
+
+constexpr size_t COMPONENT_TYPE_COUNT = static_cast<size_t>(ComponentType::SCRIPT) + 1;
+
+inline ComponentSignature SignatureOf(ComponentType type)
+{
+	return 1u << static_cast<uint32_t>(type);
+}
+
+// Components of one type are placed in fixed-size chunks, so they sit next to each
+// other in memory and never move once created (GameObject keeps raw pointers to them).
+template <typename T, size_t ChunkSize = 64>
+class ComponentPool
+{
+public:
+	static ComponentPool& Get()
+	{
+		static ComponentPool pool;
+		return pool;
+	}
+
+	void* Allocate(size_t size)
+	{
+		// Derived types (e.g. scripts) inherit the operator but do not fit in the slot
+		if (size != sizeof(T))
+			return ::operator new(size);
+
+		if (freeSlots.empty())
+			AddChunk();
+
+		void* slot = freeSlots.back();
+		freeSlots.pop_back();
+		liveCount++;
+		return slot;
+	}
+
+	void Free(void* slot, size_t size)
+	{
+		if (size != sizeof(T))
+		{
+			::operator delete(slot);
+			return;
+		}
+
+		freeSlots.push_back(slot);
+		liveCount--;
+	}
+
+	size_t GetLiveCount() const { return liveCount; }
+
+private:
+	struct Chunk
+	{
+		alignas(T) unsigned char data[sizeof(T) * ChunkSize];
+	};
+
+	void AddChunk()
+	{
+		chunks.push_back(std::make_unique<Chunk>());
+		unsigned char* data = chunks.back()->data;
+
+		for (size_t i = ChunkSize; i > 0; --i)
+			freeSlots.push_back(data + (i - 1) * sizeof(T));
+	}
+
+private:
+	std::vector<std::unique_ptr<Chunk>> chunks;
+	std::vector<void*> freeSlots;
+	size_t liveCount = 0;
+};
+
+// All GameObjects sharing the same set of component types. Each column holds, row by
+// row, the first component of that type owned by the GameObject in the same row.
+struct Archetype
+{
+	ComponentSignature signature = 0;
+	std::vector<GameObject*> gameObjects;
+	std::array<std::vector<Component*>, COMPONENT_TYPE_COUNT> columns;
+
+	bool Has(ComponentType type) const { return (signature & SignatureOf(type)) != 0; }
+	std::vector<Component*>& Column(ComponentType type) { return columns[static_cast<size_t>(type)]; }
+	size_t Size() const { return gameObjects.size(); }
+};
+
+class ComponentStorage
+{
+public:
+	ComponentStorage();
+	~ComponentStorage();
+
+	void UpdateArchetype(GameObject* gameObject);
+	void RemoveFromArchetype(GameObject* gameObject);
+
+	template <typename Func>
+	void ForEach(ComponentSignature required, Func&& func)
+	{
+		for (const auto& archetype : archetypes)
+		{
+			if ((archetype->signature & required) == required && archetype->Size() > 0)
+				func(*archetype);
+		}
+	}
+
+	size_t GetArchetypeCount() const { return archetypes.size(); }
+
+private:
+	Archetype& GetOrCreateArchetype(ComponentSignature signature);
+	void FillRow(Archetype& archetype, size_t row, const GameObject* gameObject) const;
+
+private:
+	std::vector<std::unique_ptr<Archetype>> archetypes;
+	std::unordered_map<ComponentSignature, Archetype*> archetypeBySignature;
+};
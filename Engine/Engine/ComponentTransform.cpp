@@ -7,6 +7,8 @@ ComponentTransform::ComponentTransform(GameObject* gameObject) : Component(gameO
 {
 	localTransform = glm::float4x4(1.0f);
 	globalTransform = glm::float4x4(1.0f);
+	previousGlobalTransform = glm::float4x4(1.0f);
+	fixedGlobalTransform = glm::float4x4(1.0f);
 
 	Decompose(globalTransform, position, rotation, scale);
 
@@ -19,6 +21,7 @@ ComponentTransform::~ComponentTransform()
 
 void ComponentTransform::Update()
 {
+	if (updateTransform) UpdateTransform();
 }
 
 void ComponentTransform::OnEditor()
@@ -158,6 +161,17 @@ void ComponentTransform::SetTransformMatrix(glm::float3 position, glm::quat rota
 }
 
 void ComponentTransform::UpdateTransform()
+{
+	UpdateLocalTransform();
+	UpdateGlobalTransform();
+
+	for (auto child : gameObject->children)
+	{
+		child->transform->UpdateTransform();
+	}
+}
+
+void ComponentTransform::UpdateLocalTransform()
 {
 	rotation = glm::quat(glm::vec3(glm::radians(eulerRotation.x), glm::radians(eulerRotation.y), glm::radians(eulerRotation.z)));
 
@@ -166,6 +180,11 @@ void ComponentTransform::UpdateTransform()
 	localTransform *= glm::mat4_cast(rotation);
 	localTransform = glm::scale(localTransform, scale);
 
+	updateTransform = false;
+}
+
+void ComponentTransform::UpdateGlobalTransform()
+{
 	if (gameObject->parent != nullptr)
 	{
 		ComponentTransform* parentTransform = gameObject->parent->transform;
@@ -176,16 +195,10 @@ void ComponentTransform::UpdateTransform()
 		globalTransform = localTransform;
 	}
 
-	for (auto child : gameObject->children)
-	{
-		child->transform->UpdateTransform();
-	}
-
-	updateTransform = false;
-	app->scene->octreeNeedsUpdate = true;
+	app->scene->sceneEvents.Record(SceneEventType::TRANSFORM_CHANGED, gameObject);
 }
 
-bool ComponentTransform::Decompose(const glm::float4x4& transform, glm::vec3& translation, glm::quat& rotation, glm::vec3& scale)
+bool ComponentTransform::Decompose(const glm::float4x4& transform, glm::vec3& translation, glm::quat& rotation, glm::vec3& scale) const
 {
 	glm::float4x4 localMatrix(transform);
 
@@ -213,6 +226,28 @@ bool ComponentTransform::Decompose(const glm::float4x4& transform, glm::vec3& tr
 	return true;
 }
 
+glm::float4x4 ComponentTransform::GetInterpolatedTransform(float alpha) const
+{
+	// Objects created during the last fixed steps have nothing to blend from
+	const uint32_t capture = app->scene->transformCapture;
+	if (alpha >= 1.0f || previousCapture != capture || fixedCapture != capture || previousGlobalTransform == fixedGlobalTransform)
+		return globalTransform;
+
+	glm::vec3 previousPosition, currentPosition, previousScale, currentScale;
+	glm::quat previousRotation, currentRotation;
+	Decompose(previousGlobalTransform, previousPosition, previousRotation, previousScale);
+	Decompose(fixedGlobalTransform, currentPosition, currentRotation, currentScale);
+
+	glm::float4x4 transform = glm::translate(glm::float4x4(1.0f), glm::mix(previousPosition, currentPosition, alpha));
+	transform *= glm::mat4_cast(glm::slerp(previousRotation, currentRotation, alpha));
+	transform = glm::scale(transform, glm::mix(previousScale, currentScale, alpha));
+
+	if (globalTransform != fixedGlobalTransform)
+		transform = transform * glm::inverse(fixedGlobalTransform) * globalTransform;
+
+	return transform;
+}
+
 void ComponentTransform::SetButtonColor(const char* label)
 {
 	ImVec4 buttonColor;
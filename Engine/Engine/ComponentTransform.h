@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Component.h"
+#include "ComponentStorage.h"
 #include "glm/glm.hpp"
 #define GLM_ENABLE_EXPERIMENTAL
 #include "glm/gtx/euler_angles.hpp"
@@ -12,6 +13,9 @@ public:
 	ComponentTransform(GameObject* gameObject);
 	virtual ~ComponentTransform();
 
+	static void* operator new(size_t size) { return ComponentPool<ComponentTransform>::Get().Allocate(size); }
+	static void operator delete(void* ptr, size_t size) { ComponentPool<ComponentTransform>::Get().Free(ptr, size); }
+
 	void Update() override;
 	void OnEditor() override;
 
@@ -19,9 +23,17 @@ public:
 	void Deserialize(const nlohmann::json& json) override;
 
 	void SetTransformMatrix(glm::float3 position, glm::quat rotation, glm::float3 scale, ComponentTransform* parent);
+	// Rebuilds this transform and, recursively, every child
 	void UpdateTransform();
+	// Non-recursive halves of UpdateTransform. The global one needs the parent up to date.
+	void UpdateLocalTransform();
+	void UpdateGlobalTransform();
+
+	bool Decompose(const glm::float4x4& transform, glm::vec3& translation, glm::quat& rotation, glm::vec3& scale) const;
 
-	bool Decompose(const glm::float4x4& transform, glm::vec3& translation, glm::quat& rotation, glm::vec3& scale);
+	// Blend between the global transform before and after the last fixed step, with the
+	// movement done by Update since then on top
+	glm::float4x4 GetInterpolatedTransform(float alpha) const;
 
 private:
 	void SetButtonColor(const char* label);
@@ -29,6 +41,12 @@ private:
 public:
 	glm::float4x4 localTransform;
 	glm::float4x4 globalTransform;
+	glm::float4x4 previousGlobalTransform;
+	glm::float4x4 fixedGlobalTransform;
+	uint32_t previousCapture = 0;
+	uint32_t fixedCapture = 0;
+	// Last ModuleScene transform pass that changed the global transform
+	uint32_t propagatedPass = 0;
 
 	glm::float3 position;
 	glm::quat rotation;
@@ -0,0 +1,105 @@
+#include "DebugDraw.h"
+
+void DebugDrawList::AddLine(const glm::vec3& from, const glm::vec3& to, const glm::vec4& color, float width)
+{
+	const uint32_t packed = PackColor(color);
+
+	std::vector<DebugVertex>& vertices = GetLines(width);
+	vertices.push_back({ from, packed });
+	vertices.push_back({ to, packed });
+}
+
+void DebugDrawList::AddBox(const glm::vec3* corners, const glm::vec4& color, float width)
+{
+	// Each edge joins two corners whose indices differ in one bit
+	static const int EDGES[24] = {
+		0, 4, 4, 5, 5, 1, 1, 0,	// Bottom face
+		2, 6, 6, 7, 7, 3, 3, 2,	// Top face
+		0, 2, 4, 6, 5, 7, 1, 3	// Vertical edges
+	};
+
+	const uint32_t packed = PackColor(color);
+
+	std::vector<DebugVertex>& vertices = GetLines(width);
+	for (int edge : EDGES)
+		vertices.push_back({ corners[edge], packed });
+}
+
+void DebugDrawList::AddAABB(const glm::vec3& min, const glm::vec3& max, const glm::vec4& color, float width)
+{
+	const glm::vec3 corners[8] = {
+		min,
+		glm::vec3(min.x, min.y, max.z),
+		glm::vec3(min.x, max.y, min.z),
+		glm::vec3(min.x, max.y, max.z),
+		glm::vec3(max.x, min.y, min.z),
+		glm::vec3(max.x, min.y, max.z),
+		glm::vec3(max.x, max.y, min.z),
+		max
+	};
+
+	AddBox(corners, color, width);
+}
+
+void DebugDrawList::AddPoint(const glm::vec3& position, const glm::vec4& color)
+{
+	points.push_back({ position, PackColor(color) });
+}
+
+void DebugDrawList::Append(const DebugDrawList& other)
+{
+	for (const DebugLineBatch& batch : other.lines)
+	{
+		if (batch.vertices.empty())
+			continue;
+
+		std::vector<DebugVertex>& vertices = GetLines(batch.width);
+		vertices.insert(vertices.end(), batch.vertices.begin(), batch.vertices.end());
+	}
+
+	points.insert(points.end(), other.points.begin(), other.points.end());
+}
+
+void DebugDrawList::Clear()
+{
+	for (DebugLineBatch& batch : lines)
+		batch.vertices.clear();
+	points.clear();
+}
+
+bool DebugDrawList::IsEmpty() const
+{
+	return GetVertexCount() == 0;
+}
+
+size_t DebugDrawList::GetVertexCount() const
+{
+	size_t count = points.size();
+	for (const DebugLineBatch& batch : lines)
+		count += batch.vertices.size();
+	return count;
+}
+
+std::vector<DebugVertex>& DebugDrawList::GetLines(float width)
+{
+	for (DebugLineBatch& batch : lines)
+	{
+		if (batch.width == width)
+			return batch.vertices;
+	}
+
+	lines.emplace_back();
+	lines.back().width = width;
+	return lines.back().vertices;
+}
+
+uint32_t DebugDrawList::PackColor(const glm::vec4& color)
+{
+	const glm::vec4 clamped = glm::clamp(color, 0.0f, 1.0f) * 255.0f + 0.5f;
+
+	// Bytes in memory read R, G, B, A on little endian machines
+	return static_cast<uint32_t>(clamped.r)
+		| (static_cast<uint32_t>(clamped.g) << 8)
+		| (static_cast<uint32_t>(clamped.b) << 16)
+		| (static_cast<uint32_t>(clamped.a) << 24);
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+struct DebugVertex
+{
+	glm::vec3 position;
+	uint32_t color;		// RGBA, one byte each
+};
+
+// Lines sharing a width, drawn with one call
+struct DebugLineBatch
+{
+	float width = 1.0f;
+	std::vector<DebugVertex> vertices;
+};
+
+// World space lines and points collected while a frame is built, uploaded together and
+// drawn with one call per line width plus one for the points. Not thread safe, each
+// view records its own list and ModuleDebugDraw guards the one shared by every thread.
+class DebugDrawList
+{
+public:
+	void AddLine(const glm::vec3& from, const glm::vec3& to, const glm::vec4& color, float width = 1.0f);
+
+	// Corners ordered like AABB::Transformed and OBB: x is bit 2 of the index, y bit 1, z bit 0
+	void AddBox(const glm::vec3* corners, const glm::vec4& color, float width = 1.0f);
+	void AddAABB(const glm::vec3& min, const glm::vec3& max, const glm::vec4& color, float width = 1.0f);
+
+	void AddPoint(const glm::vec3& position, const glm::vec4& color);
+
+	void Append(const DebugDrawList& other);
+
+	// Keeps the storage, lists are refilled every frame
+	void Clear();
+
+	bool IsEmpty() const;
+	size_t GetVertexCount() const;
+
+	// For loops adding many lines of one width
+	std::vector<DebugVertex>& GetLines(float width);
+
+	static uint32_t PackColor(const glm::vec4& color);
+
+public:
+	static constexpr float POINT_SIZE = 4.0f;
+
+	std::vector<DebugLineBatch> lines;
+	std::vector<DebugVertex> points;
+};
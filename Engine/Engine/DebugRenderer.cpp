@@ -0,0 +1,109 @@
+#include "DebugRenderer.h"
+
+#include <cstddef>
+
+DebugRenderer::DebugRenderer()
+{
+}
+
+DebugRenderer::~DebugRenderer()
+{
+}
+
+void DebugRenderer::CreateBuffers()
+{
+	glGenBuffers(1, &vertexBuffer);
+	glGenVertexArrays(1, &vertexArray);
+
+	glBindVertexArray(vertexArray);
+	glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+
+	const GLsizei stride = sizeof(DebugVertex);
+	const void* colorOffset = reinterpret_cast<const void*>(offsetof(DebugVertex, color));
+
+	glEnableClientState(GL_VERTEX_ARRAY);
+	glVertexPointer(3, GL_FLOAT, stride, reinterpret_cast<const void*>(0));
+
+	glEnableClientState(GL_COLOR_ARRAY);
+	glColorPointer(4, GL_UNSIGNED_BYTE, stride, colorOffset);
+
+	glEnableVertexAttribArray(ShaderAttribute::POSITION);
+	glVertexAttribPointer(ShaderAttribute::POSITION, 3, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<const void*>(0));
+
+	glEnableVertexAttribArray(ShaderAttribute::COLOR);
+	glVertexAttribPointer(ShaderAttribute::COLOR, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride, colorOffset);
+
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	glBindVertexArray(0);
+}
+
+void DebugRenderer::Draw(const DebugDrawList& list, RenderStateCache& state, const ShaderProgram* program)
+{
+	const size_t vertexCount = list.GetVertexCount();
+	if (vertexCount == 0)
+		return;
+
+	if (vertexArray == 0)
+		CreateBuffers();
+
+	glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+
+	// Orphaning the old storage lets the driver keep feeding the previous list's draws from it
+	if (vertexCount > bufferCapacity)
+		bufferCapacity = vertexCount + vertexCount / 2;
+	glBufferData(GL_ARRAY_BUFFER, bufferCapacity * sizeof(DebugVertex), nullptr, GL_STREAM_DRAW);
+
+	size_t offset = 0;
+	for (const DebugLineBatch& batch : list.lines)
+	{
+		glBufferSubData(GL_ARRAY_BUFFER, offset * sizeof(DebugVertex), batch.vertices.size() * sizeof(DebugVertex), batch.vertices.data());
+		offset += batch.vertices.size();
+	}
+	glBufferSubData(GL_ARRAY_BUFFER, offset * sizeof(DebugVertex), list.points.size() * sizeof(DebugVertex), list.points.data());
+
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	state.UseProgram(program);
+	state.BindVertexArray(vertexArray);
+	state.BindTexture(0);
+
+	// The grid fades with its alpha, every other color is opaque
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+	GLint first = 0;
+	for (const DebugLineBatch& batch : list.lines)
+	{
+		if (!batch.vertices.empty())
+		{
+			glLineWidth(batch.width);
+			state.DrawArrays(GL_LINES, first, static_cast<GLsizei>(batch.vertices.size()));
+		}
+		first += static_cast<GLint>(batch.vertices.size());
+	}
+
+	if (!list.points.empty())
+	{
+		glPointSize(DebugDrawList::POINT_SIZE);
+		state.DrawArrays(GL_POINTS, first, static_cast<GLsizei>(list.points.size()));
+		glPointSize(1.0f);
+	}
+
+	glLineWidth(1.0f);
+	glDisable(GL_BLEND);
+
+	// The fixed function color array leaves the current color undefined
+	state.Reset();
+}
+
+void DebugRenderer::Destroy()
+{
+	if (vertexArray != 0)
+		glDeleteVertexArrays(1, &vertexArray);
+	if (vertexBuffer != 0)
+		glDeleteBuffers(1, &vertexBuffer);
+
+	vertexArray = 0;
+	vertexBuffer = 0;
+	bufferCapacity = 0;
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "DebugDraw.h"
+#include "RenderState.h"
+#include "ShaderCache.h"
+
+#include <GL/glew.h>
+
+// Uploads a DebugDrawList into one stream buffer and draws it with one call per line
+// width plus one for the points. Vertex colors go through the debug draw program, or
+// through a color array with the fixed function pipeline and the camera in the matrix
+// stack.
+class DebugRenderer
+{
+public:
+	DebugRenderer();
+	~DebugRenderer();
+
+	// The buffer and vertex array are created by the first context that draws, which must
+	// also be the one destroying them. Without a program the modelview must hold the view.
+	void Draw(const DebugDrawList& list, RenderStateCache& state, const ShaderProgram* program);
+	void Destroy();
+
+private:
+	void CreateBuffers();
+
+private:
+	GLuint vertexBuffer = 0;
+	GLuint vertexArray = 0;
+	size_t bufferCapacity = 0;
+};
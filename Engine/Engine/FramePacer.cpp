@@ -0,0 +1,144 @@
+#include "FramePacer.h"
+
+#include "Timer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <timeapi.h>
+#pragma comment(lib, "winmm.lib")
+#endif
+
+FramePacer::FramePacer()
+{
+#ifdef _WIN32
+	// Default scheduler granularity is ~15.6 ms, far too coarse for a 144 Hz cap
+	timeBeginPeriod(1);
+#endif
+	lastFrameEnd = Timer::NowNs();
+	lastDeadline = lastFrameEnd;
+}
+
+FramePacer::~FramePacer()
+{
+#ifdef _WIN32
+	timeEndPeriod(1);
+#endif
+}
+
+void FramePacer::EndFrame(int targetFps)
+{
+	if (targetFps > 0)
+	{
+		const int64_t period = 1000000000LL / targetFps;
+		const int64_t now = Timer::NowNs();
+
+		// Deadlines follow each other so rounding does not accumulate. A late frame
+		// restarts the cadence instead of making the next ones shorter to catch up.
+		int64_t deadline = this->targetFps == targetFps ? lastDeadline + period : lastFrameEnd + period;
+		if (deadline <= now)
+			deadline = now;
+
+		WaitUntil(deadline);
+		lastDeadline = deadline;
+
+		sleepOvershootNs -= sleepOvershootNs / 512;
+	}
+
+	this->targetFps = targetFps;
+
+	const int64_t frameEnd = Timer::NowNs();
+	RecordFrame(frameEnd - lastFrameEnd);
+	lastFrameEnd = frameEnd;
+
+	if (targetFps <= 0)
+		lastDeadline = frameEnd;
+}
+
+void FramePacer::Restart()
+{
+	lastFrameEnd = Timer::NowNs();
+	lastDeadline = lastFrameEnd;
+}
+
+void FramePacer::WaitUntil(int64_t deadline)
+{
+	const int64_t sleepNs = 1000000;
+
+	while (true)
+	{
+		const int64_t now = Timer::NowNs();
+		const int64_t remaining = deadline - now;
+		if (remaining <= 0)
+			break;
+
+		if (remaining > sleepNs + sleepOvershootNs)
+		{
+			std::this_thread::sleep_for(std::chrono::nanoseconds(sleepNs));
+
+			// Keep the worst wake-up delay seen, EndFrame slowly forgets old spikes
+			const int64_t overshoot = Timer::NowNs() - now - sleepNs;
+			sleepOvershootNs = (std::max)(overshoot, sleepOvershootNs);
+		}
+		else
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+void FramePacer::RecordFrame(int64_t frameNs)
+{
+	lastFrameNs = frameNs;
+
+	frameHistory[historyOffset] = frameNs;
+	historyOffset = (historyOffset + 1) % HISTORY_SIZE;
+	historyCount = (std::min)(historyCount + 1, HISTORY_SIZE);
+}
+
+double FramePacer::GetAverageFrameMs() const
+{
+	if (historyCount == 0)
+		return 0.0;
+
+	int64_t total = 0;
+	for (int i = 0; i < historyCount; ++i)
+		total += frameHistory[i];
+
+	return static_cast<double>(total) / historyCount / 1000000.0;
+}
+
+double FramePacer::GetFrameTimeStdDevMs() const
+{
+	if (historyCount < 2)
+		return 0.0;
+
+	const double average = GetAverageFrameMs();
+
+	double variance = 0.0;
+	for (int i = 0; i < historyCount; ++i)
+	{
+		const double difference = frameHistory[i] / 1000000.0 - average;
+		variance += difference * difference;
+	}
+
+	return std::sqrt(variance / (historyCount - 1));
+}
+
+double FramePacer::GetMaxDeviationMs() const
+{
+	if (historyCount == 0)
+		return 0.0;
+
+	const double expected = targetFps > 0 ? 1000.0 / targetFps : GetAverageFrameMs();
+
+	double deviation = 0.0;
+	for (int i = 0; i < historyCount; ++i)
+		deviation = (std::max)(deviation, std::abs(frameHistory[i] / 1000000.0 - expected));
+
+	return deviation;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+
+// Caps the frame rate without relying on the OS sleep granularity: sleeps while the
+// deadline is far away and spins for the last stretch on a nanosecond clock.
+class FramePacer
+{
+public:
+	FramePacer();
+	~FramePacer();
+
+	// Called once at the end of every frame. A target of 0 only records the frame time
+	void EndFrame(int targetFps);
+
+	// Starts counting from now, e.g. after the loop has been blocked on purpose
+	void Restart();
+
+	double GetLastFrameMs() const { return lastFrameNs / 1000000.0; }
+	double GetAverageFrameMs() const;
+	double GetFrameTimeStdDevMs() const;
+	double GetMaxDeviationMs() const;
+
+private:
+	void WaitUntil(int64_t deadline);
+	void RecordFrame(int64_t frameNs);
+
+private:
+	static const int HISTORY_SIZE = 128;
+
+	int64_t lastFrameEnd = 0;
+	int64_t lastDeadline = 0;
+	int64_t lastFrameNs = 0;
+	int targetFps = 0;
+
+	// Longest a short sleep has been seen to overshoot, spinning covers this margin
+	int64_t sleepOvershootNs = 2000000;
+
+	int64_t frameHistory[HISTORY_SIZE] = {};
+	int historyOffset = 0;
+	int historyCount = 0;
+};
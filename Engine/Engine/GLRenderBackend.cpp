@@ -0,0 +1,140 @@
+#include "GLRenderBackend.h"
+#include "RenderSnapshot.h"
+#include "App.h"
+
+#include <glm/gtc/type_ptr.hpp>
+
+void GLRenderBackend::Execute(const RenderCommandBuffer& commands, const RenderSnapshot& snapshot)
+{
+	for (const RenderCommand& command : commands.commands)
+	{
+		switch (command.type)
+		{
+		case RenderCommandType::BEGIN_VIEW:
+			BeginView(command, commands);
+			break;
+		case RenderCommandType::SET_CULL_FACE:
+			command.flag ? glEnable(GL_CULL_FACE) : glDisable(GL_CULL_FACE);
+			break;
+		case RenderCommandType::SET_CAMERA:
+			glMatrixMode(GL_PROJECTION);
+			glLoadMatrixf(glm::value_ptr(commands.matrices[command.value]));
+			glMatrixMode(GL_MODELVIEW);
+			glLoadMatrixf(glm::value_ptr(commands.matrices[command.count]));
+			shaders.UpdateCamera(commands.matrices[command.value], commands.matrices[command.count]);
+			break;
+		case RenderCommandType::LOAD_MODELVIEW:
+			glLoadMatrixf(glm::value_ptr(commands.matrices[command.value]));
+			break;
+		case RenderCommandType::RESET_STATE:
+			state.Reset();
+			break;
+		case RenderCommandType::USE_FIXED_FUNCTION:
+			state.UseProgram(nullptr);
+			break;
+		case RenderCommandType::USE_SHADER:
+			state.UseProgram(shaders.Get(static_cast<ShaderType>(command.value)));
+			break;
+		case RenderCommandType::BIND_TEXTURE:
+			state.BindTexture(command.value);
+			break;
+		case RenderCommandType::SET_COLOR:
+			state.SetColor(command.color);
+			break;
+		case RenderCommandType::SET_POLYGON_MODE:
+			state.SetPolygonMode(command.value);
+			break;
+		case RenderCommandType::BIND_GEOMETRY:
+			state.BindVertexArray(command.page != nullptr ? command.page->GetVertexArray() : 0);
+			break;
+		case RenderCommandType::BEGIN_INSTANCES:
+			instanceRenderer.Begin(command.value);
+			break;
+		case RenderCommandType::END_INSTANCES:
+			instanceRenderer.End();
+			break;
+		case RenderCommandType::DRAW_ELEMENTS:
+			if (command.mesh->IsUploaded())
+				state.DrawElements(command.mesh->GetLodGeometry(command.value), static_cast<GLsizei>(command.count));
+			break;
+		case RenderCommandType::DRAW_RANGES:
+			if (command.mesh->IsUploaded())
+				state.MultiDrawElements(command.mesh->GetLodGeometry(0), &commands.indexRanges[command.value], command.count);
+			break;
+		case RenderCommandType::MULTI_DRAW_INDIRECT:
+			state.MultiDrawElementsIndirect(command.value, static_cast<GLsizei>(command.count), command.draws);
+			break;
+		case RenderCommandType::DRAW_OUTLINE:
+			command.mesh->DrawOutline(state, command.flag);
+			break;
+		case RenderCommandType::DRAW_DEBUG:
+			debugRenderer.Draw(command.flag ? snapshot.debugDraw : commands.debug, state, snapshot.shaders ? shaders.Get(ShaderType::DEBUG_DRAW) : nullptr);
+			break;
+		}
+	}
+}
+
+void GLRenderBackend::BeginView(const RenderCommand& command, const RenderCommandBuffer& commands)
+{
+	if (target == nullptr)
+	{
+		LOG(LogType::LOG_ERROR, "Executing a view without a render target");
+		return;
+	}
+
+	UpdateRenderTarget(*target, static_cast<int>(command.value), static_cast<int>(command.count));
+
+	glBindFramebuffer(GL_FRAMEBUFFER, target->fbo);
+	glViewport(0, 0, target->width, target->height);
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+	instanceRenderer.Upload(commands.instanceTransforms);
+	instanceRenderer.UploadCommands(commands.indirectCommands);
+}
+
+void GLRenderBackend::UpdateRenderTarget(RenderTarget& target, int width, int height)
+{
+	// Each target is resized the next time it is drawn, so the one on screen is never touched
+	if (target.fbo != 0 && target.width == width && target.height == height)
+		return;
+
+	DestroyRenderTarget(target);
+
+	target.width = width;
+	target.height = height;
+
+	glGenFramebuffers(1, &target.fbo);
+	glBindFramebuffer(GL_FRAMEBUFFER, target.fbo);
+
+	glGenTextures(1, &target.texture);
+	glBindTexture(GL_TEXTURE_2D, target.texture);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+	glBindTexture(GL_TEXTURE_2D, 0);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, target.texture, 0);
+
+	glGenRenderbuffers(1, &target.rbo);
+	glBindRenderbuffer(GL_RENDERBUFFER, target.rbo);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+	glBindRenderbuffer(GL_RENDERBUFFER, 0);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, target.rbo);
+
+	if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+		LOG(LogType::LOG_ERROR, "Framebuffer is not complete!");
+	}
+}
+
+void GLRenderBackend::DestroyRenderTarget(RenderTarget& target)
+{
+	if (target.fbo > 0)
+		glDeleteFramebuffers(1, &target.fbo);
+
+	if (target.texture > 0)
+		glDeleteTextures(1, &target.texture);
+
+	if (target.rbo > 0)
+		glDeleteRenderbuffers(1, &target.rbo);
+
+	target = RenderTarget();
+}
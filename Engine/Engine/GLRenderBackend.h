@@ -0,0 +1,44 @@
+#pragma once
+
+#include "RenderBackend.h"
+#include "RenderState.h"
+#include "InstanceRenderer.h"
+#include "DebugRenderer.h"
+#include "ShaderCache.h"
+
+#include <GL/glew.h>
+
+struct RenderTarget
+{
+	GLuint fbo = 0;
+	GLuint texture = 0;
+	GLuint rbo = 0;
+	int width = 0;
+	int height = 0;
+};
+
+// Replays command buffers against the current GL context. Redundant binds recorded
+// by the workers are filtered here by the state cache.
+class GLRenderBackend : public RenderBackend
+{
+public:
+	void Execute(const RenderCommandBuffer& commands, const RenderSnapshot& snapshot) override;
+
+	static void UpdateRenderTarget(RenderTarget& target, int width, int height);
+	static void DestroyRenderTarget(RenderTarget& target);
+
+public:
+	// Where the next executed view is drawn, resized to the size it was recorded with
+	RenderTarget* target = nullptr;
+
+	// Only used by the thread that executes snapshots
+	RenderStateCache state;
+
+	// Built in the main context, shared with the render thread
+	ShaderCache shaders;
+	InstanceRenderer instanceRenderer;
+	DebugRenderer debugRenderer;
+
+private:
+	void BeginView(const RenderCommand& command, const RenderCommandBuffer& commands);
+};
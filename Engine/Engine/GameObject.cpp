@@ -1,37 +1,33 @@
 #include "GameObject.h"
 
-#include <random>
-
 #include "App.h"
 #include "ComponentScript.h"
 
-GameObject::GameObject(const char* name, GameObject* parent) : parent(parent), name(name), uuid(GenerateUUID())
+GameObject::GameObject(const char* name, GameObject* parent) : parent(parent), name(name), uid(UID::Generate())
 {
 	transform = new ComponentTransform(this);
-	mesh = new ComponentMesh(this);
-	material = new ComponentMaterial(this);
+
+	registrySlot = app->scene->sceneRegistry.Register(this);
+	app->scene->sceneEvents.Record(SceneEventType::OBJECT_CREATED, this);
 
 	AddComponent(transform);
 }
 
 GameObject::~GameObject()
 {
+    app->scene->sceneEvents.Record(SceneEventType::OBJECT_DESTROYED, this);
+
+    DetachFromParent();
+
     for (auto& child : children)
     {
+        // Already being removed with us, skip their own detach
+        child->parent = nullptr;
         delete child;
         child = nullptr;
     }
     children.clear();
 
-    if (std::find(components.begin(), components.end(), transform) == components.end() && transform)
-        delete transform;
-
-    if (std::find(components.begin(), components.end(), mesh) == components.end() && mesh)
-        delete mesh;
-
-    if (std::find(components.begin(), components.end(), material) == components.end() && material)
-        delete material;
-
     for (auto& component : components)
     {
         delete component;
@@ -42,45 +38,75 @@ GameObject::~GameObject()
     transform = nullptr;
     mesh = nullptr;
     material = nullptr;
+
+    app->scene->componentStorage.RemoveFromArchetype(this);
+    app->scene->sceneRegistry.Unregister(this);
 }
 
-void GameObject::Update()
+void GameObject::Enable()
 {
-	if (isActive)
-	{
-		for (std::vector<Component*>::iterator it = components.begin(); it != components.end(); ++it)
-		{
-			if ((*it)->type == ComponentType::SCRIPT && !(app->time.GetState() == GameState::PLAY || app->time.GetState() == GameState::STEP))
-				continue;
+}
+void GameObject::Disable()
+{
+}
 
-			(*it)->Update();
-		}
-		for (std::vector<GameObject*>::iterator it = children.begin(); it != children.end(); ++it)
-		{
-			(*it)->Update();
-		}
-	}
+void GameObject::SetParent(GameObject* newParent)
+{
+	DetachFromParent();
 
-    isParentSelected = parent && (app->editor->selectedGameObject == parent || parent->isParentSelected);
+	parent = newParent;
 
-    if (mesh)
-        mesh->drawOutline = isParentSelected || app->editor->selectedGameObject == this;
-}
+	if (parent != nullptr)
+		parent->children.push_back(this);
 
-void GameObject::Enable()
-{
+	app->scene->sceneRegistry.MarkHierarchyDirty();
+	app->scene->sceneEvents.Record(SceneEventType::REPARENTED, this);
 }
-void GameObject::Disable()
+
+void GameObject::DetachFromParent()
 {
+	if (parent == nullptr)
+		return;
+
+	auto it = std::find(parent->children.begin(), parent->children.end(), this);
+	if (it != parent->children.end())
+		parent->children.erase(it);
+
+	parent = nullptr;
 }
 
 Component* GameObject::AddComponent(Component* component)
 {
 	components.push_back(component);
+	app->scene->componentStorage.UpdateArchetype(this);
+	app->scene->sceneEvents.Record(SceneEventType::COMPONENT_ADDED, this, component->type);
 
 	return component;
 }
 
+bool GameObject::RemoveComponent(Component* component)
+{
+	if (component == nullptr || component == transform)
+		return false;
+
+	auto it = std::find(components.begin(), components.end(), component);
+	if (it == components.end())
+		return false;
+
+	components.erase(it);
+	app->scene->componentStorage.UpdateArchetype(this);
+	app->scene->sceneEvents.Record(SceneEventType::COMPONENT_REMOVED, this, component->type);
+
+	if (component == mesh)
+		mesh = nullptr;
+	else if (component == material)
+		material = nullptr;
+
+	delete component;
+
+	return true;
+}
+
 Component* GameObject::GetComponent(ComponentType type)
 {
 	for (auto it = components.begin(); it != components.end(); ++it) {
@@ -92,6 +118,41 @@ Component* GameObject::GetComponent(ComponentType type)
 	return nullptr;
 }
 
+ComponentMesh* GameObject::GetOrCreateMesh()
+{
+	if (mesh == nullptr)
+	{
+		mesh = new ComponentMesh(this);
+		AddComponent(mesh);
+	}
+
+	return mesh;
+}
+
+ComponentMaterial* GameObject::GetOrCreateMaterial()
+{
+	if (material == nullptr)
+	{
+		material = new ComponentMaterial(this);
+		AddComponent(material);
+	}
+
+	return material;
+}
+
+void GameObject::ApplyTexture(Texture* texture)
+{
+	if (mesh != nullptr)
+		GetOrCreateMaterial()->SetTexture(texture);
+
+	// Grouping nodes have nothing to texture, a material there would only be clutter
+	for (auto& child : children)
+	{
+		if (child->mesh != nullptr)
+			child->GetOrCreateMaterial()->SetTexture(texture);
+	}
+}
+
 AABB GameObject::GetAABB()
 {
 	if (transform != nullptr && mesh != nullptr && mesh->mesh != nullptr)
@@ -165,9 +226,10 @@ bool GameObject::IntersectsRay(const glm::vec3& rayOrigin, const glm::vec3& rayD
 void GameObject::Serialize(nlohmann::json& json) const
 {
     json["name"] = name;
-	json["uuid"] = uuid;
+	json["uuid"] = uid.ToString();
 
-    json["parent"] = (parent != nullptr && parent->parent != nullptr) ? parent->uuid : "";
+    json["parent"] = (parent != nullptr && parent->parent != nullptr) ? parent->uid.ToString() : "";
+	json["static"] = isStatic;
 
 	json["components"] = nlohmann::json::array();
     for (auto& component : components)
@@ -180,6 +242,8 @@ void GameObject::Serialize(nlohmann::json& json) const
 
 void GameObject::Deserialize(const nlohmann::json& json)
 {
+	isStatic = json.value("static", false);
+
     for (const auto& componentJson : json["components"])
     {
         ComponentType type = static_cast<ComponentType>(componentJson["type"].get<int>());
@@ -191,10 +255,10 @@ void GameObject::Deserialize(const nlohmann::json& json)
 			component = transform;
             break;
         case ComponentType::MESH:
-            component = mesh;
+            component = GetOrCreateMesh();
             break;
         case ComponentType::MATERIAL:
-            component = material;
+            component = GetOrCreateMaterial();
             break;
         case ComponentType::CAMERA:
             component = new ComponentCamera(this);
@@ -208,29 +272,10 @@ void GameObject::Deserialize(const nlohmann::json& json)
 
         if (component)
         {
-            if (type != ComponentType::TRANSFORM)
+            if (type == ComponentType::CAMERA || type == ComponentType::SCRIPT)
 				AddComponent(component);
 
 			component->Deserialize(componentJson);
         }
     }
 }
-
-std::string GameObject::GenerateUUID()
-{
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<int> dis(0, 15);
-    std::uniform_int_distribution<int> dis2(8, 11);
-
-    std::string uuid = "xxxxxxxx-xxxx-4xxx-yxxx-xxxxxxxxxxxx";
-    for (char& c : uuid) {
-        if (c == 'x') {
-            c = "0123456789abcdef"[dis(gen)];
-        }
-        else if (c == 'y') {
-            c = "89ab"[dis2(gen)];
-        }
-    }
-    return uuid;
-}
\ No newline at end of file
@@ -4,6 +4,8 @@
 #include "ComponentTransform.h"
 #include "ComponentMesh.h"
 #include "ComponentMaterial.h"
+#include "ComponentStorage.h"
+#include "UID.h"
 #include <nlohmann/json.hpp>
 
 #include <string>
@@ -16,14 +18,23 @@ public:
 	GameObject(const char* name, GameObject* parent);
 	virtual ~GameObject();
 
-	void Update();
-
 	void Enable();
 	void Disable();
 
+	void SetParent(GameObject* newParent);
+
 	Component* AddComponent(Component* component);
+	bool RemoveComponent(Component* component);
 	Component* GetComponent(ComponentType type);
 
+	ComponentMesh* GetOrCreateMesh();
+	ComponentMaterial* GetOrCreateMaterial();
+	void ApplyTexture(Texture* texture);
+	bool HasComponents(ComponentSignature required) const { return (signature & required) == required; }
+
+	uint32_t GetRegistrySlot() const { return registrySlot; }
+	uint64_t GetRegistrySerial() const { return registrySerial; }
+
 	AABB GetAABB();
 
 	bool IntersectsRay(const glm::vec3& rayOrigin, const glm::vec3& rayDirection, float& intersectionDistance) const;
@@ -31,17 +42,16 @@ public:
 	void Serialize(nlohmann::json& json) const;
 	void Deserialize(const nlohmann::json& json);
 
-	std::string GenerateUUID();
 
 public:
 	GameObject* parent;
 	std::string name;
 
-	std::string uuid;
+	UID uid;
 
-	ComponentTransform* transform;
-	ComponentMesh* mesh;
-	ComponentMaterial* material;
+	ComponentTransform* transform = nullptr;
+	ComponentMesh* mesh = nullptr;
+	ComponentMaterial* material = nullptr;
 
 	std::vector<Component*> components;
 	std::vector<GameObject*> children;
@@ -52,7 +62,22 @@ public:
 	bool isOctreeInSceneFrustum = true;
 	bool isOctreeInGameFrustum = true;
 	bool isParentSelected = false;
+	// isActive of the object and every parent, refreshed by ModuleScene::UpdateTransforms
+	bool activeInHierarchy = true;
+
+	ComponentSignature signature = 0;
 
 private:
+	friend class ComponentStorage;
+	friend class SceneRegistry;
+
+	void DetachFromParent();
+
 	AABB aabb;
+
+	Archetype* archetype = nullptr;
+	size_t archetypeRow = 0;
+
+	uint32_t registrySlot = UINT32_MAX;
+	uint64_t registrySerial = 0;
 };
\ No newline at end of file
@@ -102,7 +102,7 @@ void GameWindow::DrawTimeOverlay()
 
 	if (ImGui::Begin("Time Overlay", nullptr, ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoFocusOnAppearing | ImGuiWindowFlags_NoNav))
 	{
-		ImGui::Text("Frame Count: %.0f", app->time.GetFrameCount());
+		ImGui::Text("Frame Count: %llu", static_cast<unsigned long long>(app->time.GetFrameCount()));
 		ImGui::Text("Time Since Startup: %.2f s", app->time.GetTimeSinceStartup());
 		ImGui::Text("Time Scale: %.2f", app->time.GetTimeScale());
 		ImGui::Text("Delta Time: %.2f ms", app->time.GetDeltaTime());
@@ -0,0 +1,198 @@
+#include "GeometryPool.h"
+#include "ShaderCache.h"
+
+#include <algorithm>
+
+RangeAllocator::RangeAllocator(uint32_t capacity)
+{
+	freeRanges[0] = capacity;
+}
+
+uint32_t RangeAllocator::Allocate(uint32_t size)
+{
+	for (auto it = freeRanges.begin(); it != freeRanges.end(); ++it)
+	{
+		if (it->second < size)
+			continue;
+
+		const uint32_t offset = it->first;
+		const uint32_t remaining = it->second - size;
+		freeRanges.erase(it);
+
+		if (remaining > 0)
+			freeRanges[offset + size] = remaining;
+
+		return offset;
+	}
+
+	return UINT32_MAX;
+}
+
+void RangeAllocator::Free(uint32_t offset, uint32_t size)
+{
+	auto next = freeRanges.lower_bound(offset);
+
+	if (next != freeRanges.begin())
+	{
+		auto previous = std::prev(next);
+		if (previous->first + previous->second == offset)
+		{
+			offset = previous->first;
+			size += previous->second;
+			freeRanges.erase(previous);
+		}
+	}
+
+	if (next != freeRanges.end() && offset + size == next->first)
+	{
+		size += next->second;
+		freeRanges.erase(next);
+	}
+
+	freeRanges[offset] = size;
+}
+
+GeometryPage::GeometryPage(uint32_t vertexCapacity, uint32_t indexCapacity) : vertices(vertexCapacity), indices(indexCapacity)
+{
+}
+
+GLuint GeometryPage::GetVertexArray() const
+{
+	if (vertexArray == 0)
+	{
+		glGenVertexArrays(1, &vertexArray);
+		glBindVertexArray(vertexArray);
+
+		glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+
+		glEnableClientState(GL_VERTEX_ARRAY);
+		glVertexPointer(3, GL_FLOAT, GeometryPool::VERTEX_STRIDE, reinterpret_cast<const void*>(0));
+
+		glEnableClientState(GL_NORMAL_ARRAY);
+		glNormalPointer(GL_FLOAT, GeometryPool::VERTEX_STRIDE, reinterpret_cast<const void*>(3 * sizeof(float)));
+
+		glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+		glTexCoordPointer(2, GL_FLOAT, GeometryPool::VERTEX_STRIDE, reinterpret_cast<const void*>(6 * sizeof(float)));
+
+		// The same data again for the shader pipeline
+		glEnableVertexAttribArray(ShaderAttribute::POSITION);
+		glVertexAttribPointer(ShaderAttribute::POSITION, 3, GL_FLOAT, GL_FALSE, GeometryPool::VERTEX_STRIDE, reinterpret_cast<const void*>(0));
+
+		glEnableVertexAttribArray(ShaderAttribute::NORMAL);
+		glVertexAttribPointer(ShaderAttribute::NORMAL, 3, GL_FLOAT, GL_FALSE, GeometryPool::VERTEX_STRIDE, reinterpret_cast<const void*>(3 * sizeof(float)));
+
+		glEnableVertexAttribArray(ShaderAttribute::TEXCOORD);
+		glVertexAttribPointer(ShaderAttribute::TEXCOORD, 2, GL_FLOAT, GL_FALSE, GeometryPool::VERTEX_STRIDE, reinterpret_cast<const void*>(6 * sizeof(float)));
+
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+	}
+
+	return vertexArray;
+}
+
+GeometryAllocation GeometryPool::Allocate(const float* vertexData, uint32_t vertexCount, const uint32_t* indexData, uint32_t indexCount)
+{
+	std::lock_guard<std::mutex> lock(poolMutex);
+
+	GeometryAllocation allocation;
+	allocation.vertexCount = vertexCount;
+	allocation.indexCount = indexCount;
+
+	for (const auto& page : pages)
+	{
+		const uint32_t baseVertex = page->vertices.Allocate(vertexCount);
+		if (baseVertex == UINT32_MAX)
+			continue;
+
+		const uint32_t firstIndex = page->indices.Allocate(indexCount);
+		if (firstIndex == UINT32_MAX)
+		{
+			page->vertices.Free(baseVertex, vertexCount);
+			continue;
+		}
+
+		allocation.page = page.get();
+		allocation.baseVertex = baseVertex;
+		allocation.firstIndex = firstIndex;
+		break;
+	}
+
+	if (allocation.page == nullptr)
+	{
+		// Meshes larger than a page get one of their own
+		GeometryPage* page = CreatePage((std::max)(vertexCount, PAGE_VERTICES), (std::max)(indexCount, PAGE_INDICES));
+		allocation.page = page;
+		allocation.baseVertex = page->vertices.Allocate(vertexCount);
+		allocation.firstIndex = page->indices.Allocate(indexCount);
+	}
+
+	allocation.page->liveAllocations++;
+
+	glBindBuffer(GL_ARRAY_BUFFER, allocation.page->vertexBuffer);
+	glBufferSubData(GL_ARRAY_BUFFER, static_cast<GLintptr>(allocation.baseVertex) * VERTEX_STRIDE, static_cast<GLsizeiptr>(vertexCount) * VERTEX_STRIDE, vertexData);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	// Through the copy buffer target, the element binding belongs to whatever vertex array is bound
+	glBindBuffer(GL_COPY_WRITE_BUFFER, allocation.page->indexBuffer);
+	glBufferSubData(GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(allocation.firstIndex) * sizeof(uint32_t), static_cast<GLsizeiptr>(indexCount) * sizeof(uint32_t), indexData);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+	return allocation;
+}
+
+void GeometryPool::Free(GeometryAllocation& allocation)
+{
+	if (allocation.page == nullptr)
+		return;
+
+	std::lock_guard<std::mutex> lock(poolMutex);
+
+	allocation.page->vertices.Free(allocation.baseVertex, allocation.vertexCount);
+	allocation.page->indices.Free(allocation.firstIndex, allocation.indexCount);
+	allocation.page->liveAllocations--;
+	allocation.page = nullptr;
+}
+
+void GeometryPool::ReleaseVertexArrays()
+{
+	std::lock_guard<std::mutex> lock(poolMutex);
+
+	for (const auto& page : pages)
+	{
+		if (page->vertexArray != 0)
+			glDeleteVertexArrays(1, &page->vertexArray);
+		page->vertexArray = 0;
+	}
+}
+
+void GeometryPool::Destroy()
+{
+	std::lock_guard<std::mutex> lock(poolMutex);
+
+	for (const auto& page : pages)
+	{
+		glDeleteBuffers(1, &page->vertexBuffer);
+		glDeleteBuffers(1, &page->indexBuffer);
+		page->vertexBuffer = 0;
+		page->indexBuffer = 0;
+	}
+}
+
+GeometryPage* GeometryPool::CreatePage(uint32_t vertexCapacity, uint32_t indexCapacity)
+{
+	GeometryPage* page = new GeometryPage(vertexCapacity, indexCapacity);
+
+	glGenBuffers(1, &page->vertexBuffer);
+	glBindBuffer(GL_ARRAY_BUFFER, page->vertexBuffer);
+	glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(vertexCapacity) * VERTEX_STRIDE, nullptr, GL_STATIC_DRAW);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	glGenBuffers(1, &page->indexBuffer);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, page->indexBuffer);
+	glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(indexCapacity) * sizeof(uint32_t), nullptr, GL_STATIC_DRAW);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+	pages.emplace_back(page);
+	return page;
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// First fit over a fixed capacity, freed ranges are merged with their neighbours
+class RangeAllocator
+{
+public:
+	explicit RangeAllocator(uint32_t capacity);
+
+	// Returns UINT32_MAX when no free range is large enough
+	uint32_t Allocate(uint32_t size);
+	void Free(uint32_t offset, uint32_t size);
+
+private:
+	std::map<uint32_t, uint32_t> freeRanges;
+};
+
+// One shared vertex buffer and index buffer. Never resized, so the vertex array that
+// describes them stays valid for as long as the page lives.
+class GeometryPage
+{
+public:
+	GeometryPage(uint32_t vertexCapacity, uint32_t indexCapacity);
+
+	// Created on first use by the context that draws
+	GLuint GetVertexArray() const;
+
+public:
+	GLuint vertexBuffer = 0;
+	GLuint indexBuffer = 0;
+	RangeAllocator vertices;
+	RangeAllocator indices;
+	uint32_t liveAllocations = 0;
+
+private:
+	friend class GeometryPool;
+	mutable GLuint vertexArray = 0;
+};
+
+// Layout read by glMultiDrawElementsIndirect
+struct DrawElementsIndirectCommand
+{
+	uint32_t count;
+	uint32_t instanceCount;
+	uint32_t firstIndex;
+	int32_t baseVertex;
+	uint32_t baseInstance;
+};
+
+// Part of an allocation's indices, firstIndex relative to the allocation
+struct IndexRange
+{
+	uint32_t firstIndex;
+	uint32_t indexCount;
+};
+
+struct GeometryAllocation
+{
+	GeometryPage* page = nullptr;
+	uint32_t baseVertex = 0;
+	uint32_t vertexCount = 0;
+	uint32_t firstIndex = 0;
+	uint32_t indexCount = 0;
+};
+
+// Every mesh uploads its interleaved vertices and indices into shared pages, so draws
+// of different meshes only differ by offsets and can be merged into indirect calls.
+class GeometryPool
+{
+public:
+	static GeometryPool& Get()
+	{
+		static GeometryPool pool;
+		return pool;
+	}
+
+	// Main context. vertexData holds VERTEX_FLOATS floats per vertex.
+	GeometryAllocation Allocate(const float* vertexData, uint32_t vertexCount, const uint32_t* indexData, uint32_t indexCount);
+	void Free(GeometryAllocation& allocation);
+
+	// Called by the context that drew from the pool before it goes away
+	void ReleaseVertexArrays();
+	// Deletes every buffer. Allocations freed afterwards only update the bookkeeping.
+	void Destroy();
+
+	size_t GetPageCount() const { return pages.size(); }
+
+public:
+	static const uint32_t VERTEX_FLOATS = 8;
+	static const uint32_t VERTEX_STRIDE = VERTEX_FLOATS * sizeof(float);
+
+	static const uint32_t PAGE_VERTICES = 1 << 20;
+	static const uint32_t PAGE_INDICES = 3 << 20;
+
+private:
+	GeometryPool() {}
+
+	GeometryPage* CreatePage(uint32_t vertexCapacity, uint32_t indexCapacity);
+
+private:
+	std::mutex poolMutex;
+	std::vector<std::unique_ptr<GeometryPage>> pages;
+};
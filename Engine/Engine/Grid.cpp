@@ -1,20 +1,14 @@
 #include "Grid.h"
-#include "GL/glew.h"
+
+#include <cmath>
 
 Grid::Grid()
 {
 }
 
-void Grid::Render() const
+void Grid::AddLines(DebugDrawList& list) const
 {
-	glLineWidth(lineWidth);
-
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-	glColor4f(lineColor[0], lineColor[1], lineColor[2], lineColor[3]);
-
-	glBegin(GL_LINES);
+	const glm::vec4 color(lineColor[0], lineColor[1], lineColor[2], lineColor[3]);
 
 	float start = -gridSize - fmod(-gridSize, cellSize);
 	float end = gridSize - fmod(gridSize, cellSize);
@@ -23,35 +17,24 @@ void Grid::Render() const
 		// Grid YZ
 		for (float i = start; i <= end; i += cellSize)
 		{
-			glVertex3f(0.0f, i, -gridSize);
-			glVertex3f(0.0f, i, gridSize);
-			glVertex3f(0.0f, -gridSize, i);
-			glVertex3f(0.0f, gridSize, i);
+			list.AddLine(glm::vec3(0.0f, i, -gridSize), glm::vec3(0.0f, i, gridSize), color, lineWidth);
+			list.AddLine(glm::vec3(0.0f, -gridSize, i), glm::vec3(0.0f, gridSize, i), color, lineWidth);
 		}
 	}
 	else if (normal.y == 1.0f) {
 		// Grid XZ
 		for (float i = start; i <= end; i += cellSize)
 		{
-			glVertex3f(i, 0.0f, -gridSize);
-			glVertex3f(i, 0.0f, gridSize);
-			glVertex3f(-gridSize, 0.0f, i);
-			glVertex3f(gridSize, 0.0f, i);
+			list.AddLine(glm::vec3(i, 0.0f, -gridSize), glm::vec3(i, 0.0f, gridSize), color, lineWidth);
+			list.AddLine(glm::vec3(-gridSize, 0.0f, i), glm::vec3(gridSize, 0.0f, i), color, lineWidth);
 		}
 	}
 	else if (normal.z == 1.0f) {
 		// Grid XY
 		for (float i = start; i <= end; i += cellSize)
 		{
-			glVertex3f(i, -gridSize, 0.0f);
-			glVertex3f(i, gridSize, 0.0f);
-			glVertex3f(-gridSize, i, 0.0f);
-			glVertex3f(gridSize, i, 0.0f);
+			list.AddLine(glm::vec3(i, -gridSize, 0.0f), glm::vec3(i, gridSize, 0.0f), color, lineWidth);
+			list.AddLine(glm::vec3(-gridSize, i, 0.0f), glm::vec3(gridSize, i, 0.0f), color, lineWidth);
 		}
 	}
-
-	glEnd();
-
-	glDisable(GL_BLEND);
-	glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
-}
\ No newline at end of file
+}
@@ -1,12 +1,13 @@
 #pragma once
 
 #include "glm/glm.hpp"
+#include "DebugDraw.h"
 
 class Grid
 {
 public:
 	Grid();
-	void Render() const;
+	void AddLines(DebugDrawList& list) const;
 public:
 	glm::vec3 normal = glm::vec3(0, 1, 0);
 
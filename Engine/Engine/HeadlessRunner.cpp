@@ -0,0 +1,95 @@
+#include "HeadlessRunner.h"
+#include "Module.h"
+#include "Timer.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+HeadlessRunner::HeadlessRunner()
+{
+}
+
+HeadlessRunner::~HeadlessRunner()
+{
+}
+
+void HeadlessRunner::ParseArguments(int argc, char* argv[])
+{
+	for (int i = 1; i < argc; ++i)
+	{
+		if (strcmp(argv[i], "--headless") == 0)
+			enabled = true;
+		else if (strcmp(argv[i], "--scene") == 0 && i + 1 < argc)
+			scenePath = argv[++i];
+		else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc)
+			frameCount = (std::max)(atoi(argv[++i]), 1);
+		else if (strcmp(argv[i], "--commands") == 0 && i + 1 < argc)
+			commandsPath = argv[++i];
+	}
+
+	if (enabled)
+		frameTimes.reserve(frameCount);
+}
+
+void HeadlessRunner::BeginFrame()
+{
+	frameStart = Timer::NowNs();
+	if (frameTimes.empty())
+		runStart = frameStart;
+}
+
+void HeadlessRunner::RecordModule(const Module* module, int64_t ns)
+{
+	for (ModuleTime& entry : moduleTimes)
+	{
+		if (entry.module == module)
+		{
+			entry.totalNs += ns;
+			return;
+		}
+	}
+
+	moduleTimes.push_back({ module, ns });
+}
+
+bool HeadlessRunner::EndFrame(uint32_t visibleMeshes)
+{
+	frameTimes.push_back(Timer::NowNs() - frameStart);
+	visibleMeshTotal += visibleMeshes;
+
+	return static_cast<int>(frameTimes.size()) >= frameCount;
+}
+
+void HeadlessRunner::PrintReport() const
+{
+	if (frameTimes.empty())
+		return;
+
+	std::vector<int64_t> sorted = frameTimes;
+	std::sort(sorted.begin(), sorted.end());
+
+	int64_t total = 0;
+	for (int64_t frame : sorted)
+		total += frame;
+
+	const double frames = static_cast<double>(sorted.size());
+	const auto ms = [](int64_t ns) { return ns / 1000000.0; };
+	const auto percentile = [&sorted](double p) { return sorted[static_cast<size_t>(p * (sorted.size() - 1))]; };
+
+	printf("Headless run: %d frames of %s\n", static_cast<int>(sorted.size()), scenePath.empty() ? "the default scene" : scenePath.c_str());
+	printf("  wall time      %10.2f ms\n", ms(Timer::NowNs() - runStart));
+	printf("  frame avg      %10.3f ms\n", ms(total) / frames);
+	printf("  frame min      %10.3f ms\n", ms(sorted.front()));
+	printf("  frame p50      %10.3f ms\n", ms(percentile(0.50)));
+	printf("  frame p95      %10.3f ms\n", ms(percentile(0.95)));
+	printf("  frame p99      %10.3f ms\n", ms(percentile(0.99)));
+	printf("  frame max      %10.3f ms\n", ms(sorted.back()));
+	printf("  visible meshes %10.1f avg\n", visibleMeshTotal / frames);
+
+	for (const ModuleTime& entry : moduleTimes)
+		printf("  %-14s %10.3f ms/frame\n", entry.module->name, ms(entry.totalNs) / frames);
+
+	fflush(stdout);
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class Module;
+
+// Runs the simulation without a window, GL context or editor: loads a scene, plays it
+// for a fixed number of frames and prints timing stats. Enabled from the command line:
+//   Engine.exe --headless [--scene Assets/Scenes/Street.scene] [--frames 600] [--commands commands.txt]
+// --commands writes the render commands recorded for the last frame to the given file.
+class HeadlessRunner
+{
+public:
+	HeadlessRunner();
+	~HeadlessRunner();
+
+	void ParseArguments(int argc, char* argv[]);
+
+	bool IsEnabled() const { return enabled; }
+	const std::string& GetScenePath() const { return scenePath; }
+	const std::string& GetCommandsPath() const { return commandsPath; }
+
+	void BeginFrame();
+	void RecordModule(const Module* module, int64_t ns);
+
+	// Returns true once every requested frame has run
+	bool EndFrame(uint32_t visibleMeshes);
+
+	void PrintReport() const;
+
+private:
+	struct ModuleTime
+	{
+		const Module* module;
+		int64_t totalNs;
+	};
+
+	bool enabled = false;
+	std::string scenePath;
+	std::string commandsPath;
+	int frameCount = 600;
+
+	int64_t runStart = 0;
+	int64_t frameStart = 0;
+	std::vector<int64_t> frameTimes;
+	std::vector<ModuleTime> moduleTimes;
+	uint64_t visibleMeshTotal = 0;
+};
@@ -86,22 +86,16 @@ void HierarchyWindow::DrawWindow()
 		{
 			GameObject* newParent = app->scene->CreateGameObject("GameObject", selectedNode->parent);
 
-			RemoveNodeFromParent(selectedNode);
-
-			selectedNode->parent = newParent;
-			newParent->children.push_back(selectedNode);
+			selectedNode->SetParent(newParent);
 
 			app->editor->selectedGameObject = newParent;
 		}
 		if (ImGui::MenuItem("Delete", nullptr, false, selectedNode != app->scene->root))
 		{
-			RemoveNodeFromParent(selectedNode);
-
 			delete selectedNode;
 			selectedNode = nullptr;
 
 			app->editor->selectedGameObject = nullptr;
-			app->scene->octreeNeedsUpdate = true;
 		}
 		ImGui::EndPopup();
 	}
@@ -165,9 +159,7 @@ void HierarchyWindow::HandleDragAndDrop(GameObject* node) const
 					glm::quat newRotation;
 					droppedNode->transform->Decompose(newLocalTransform, newPosition, newRotation, newScale);
 
-					RemoveNodeFromParent(droppedNode);
-					droppedNode->parent = node;
-					node->children.push_back(droppedNode);
+					droppedNode->SetParent(node);
 
 					droppedNode->transform->SetTransformMatrix(newPosition, newRotation, newScale, node->transform);
 					droppedNode->transform->updateTransform = true;
@@ -282,16 +274,4 @@ bool HierarchyWindow::FilterNode(GameObject* node, const char* searchText)
 	std::transform(searchTextLower.begin(), searchTextLower.end(), searchTextLower.begin(), ::tolower);
 
 	return nodeNameLower.find(searchTextLower) != std::string::npos;
-}
-
-void HierarchyWindow::RemoveNodeFromParent(const GameObject* node) const
-{
-	if (node->parent)
-	{
-		auto it = std::find(node->parent->children.begin(),
-			node->parent->children.end(),
-			node);
-		if (it != node->parent->children.end())
-			node->parent->children.erase(it);
-	}
 }
\ No newline at end of file
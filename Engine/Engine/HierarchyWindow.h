@@ -13,7 +13,6 @@ public:
 
 	void HierarchyTree(GameObject* node, bool isRoot = false, const char* searchText = "");
 	bool FilterNode(GameObject* node, const char* searchText);
-	void RemoveNodeFromParent(const GameObject* node) const;
 	void HandleDragAndDrop(GameObject* node) const;
 
 private:
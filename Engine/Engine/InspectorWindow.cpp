@@ -18,7 +18,8 @@ void InspectorWindow::DrawWindow()
 
 	if (app->editor->selectedGameObject != nullptr && app->editor->selectedGameObject->parent != nullptr)
 	{
-		ImGui::Checkbox("##Active", &app->editor->selectedGameObject->isActive);
+		if (ImGui::Checkbox("##Active", &app->editor->selectedGameObject->isActive))
+			app->scene->sceneEvents.Record(SceneEventType::STATE_CHANGED, app->editor->selectedGameObject);
 		ImGui::SameLine();
 
 		strcpy_s(inputName, app->editor->selectedGameObject->name.c_str());
@@ -37,7 +38,8 @@ void InspectorWindow::DrawWindow()
 		}
 		
 		ImGui::SameLine();
-		ImGui::Checkbox("Static", &app->editor->selectedGameObject->isStatic);
+		if (ImGui::Checkbox("Static", &app->editor->selectedGameObject->isStatic))
+			app->scene->sceneEvents.Record(SceneEventType::STATE_CHANGED, app->editor->selectedGameObject);
 
 		for (auto i = 0; i < app->editor->selectedGameObject->components.size(); i++)
 		{
@@ -0,0 +1,93 @@
+#include "InstanceRenderer.h"
+#include "App.h"
+
+InstanceRenderer::InstanceRenderer()
+{
+}
+
+InstanceRenderer::~InstanceRenderer()
+{
+}
+
+bool InstanceRenderer::Init()
+{
+	if (initialized)
+		return IsAvailable();
+
+	initialized = true;
+
+	if (!GLEW_VERSION_3_3)
+	{
+		LOG(LogType::LOG_WARNING, "Per-draw data needs OpenGL 3.3, meshes are drawn one by one");
+		return false;
+	}
+
+	glGenBuffers(1, &instanceBuffer);
+	glGenBuffers(1, &commandBuffer);
+
+	return true;
+}
+
+void InstanceRenderer::Destroy()
+{
+	if (instanceBuffer != 0)
+		glDeleteBuffers(1, &instanceBuffer);
+	if (commandBuffer != 0)
+		glDeleteBuffers(1, &commandBuffer);
+
+	instanceBuffer = 0;
+	commandBuffer = 0;
+	bufferCapacity = 0;
+	commandCapacity = 0;
+	initialized = false;
+}
+
+void InstanceRenderer::Upload(const std::vector<glm::mat4>& transforms)
+{
+	if (!IsAvailable() || transforms.empty())
+		return;
+
+	glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+
+	// Orphaning the old storage lets the driver keep feeding the previous view's draws from it
+	if (transforms.size() > bufferCapacity)
+		bufferCapacity = transforms.size() + transforms.size() / 2;
+	glBufferData(GL_ARRAY_BUFFER, bufferCapacity * sizeof(glm::mat4), nullptr, GL_STREAM_DRAW);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, transforms.size() * sizeof(glm::mat4), transforms.data());
+
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void InstanceRenderer::UploadCommands(const std::vector<DrawElementsIndirectCommand>& commands)
+{
+	if (!SupportsMultiDraw() || commands.empty())
+		return;
+
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, commandBuffer);
+
+	if (commands.size() > commandCapacity)
+		commandCapacity = commands.size() + commands.size() / 2;
+	glBufferData(GL_DRAW_INDIRECT_BUFFER, commandCapacity * sizeof(DrawElementsIndirectCommand), nullptr, GL_STREAM_DRAW);
+	glBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, commands.size() * sizeof(DrawElementsIndirectCommand), commands.data());
+}
+
+void InstanceRenderer::Begin(size_t firstInstance)
+{
+	glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+	for (GLuint column = 0; column < 4; ++column)
+	{
+		const size_t offset = firstInstance * sizeof(glm::mat4) + column * sizeof(glm::vec4);
+
+		glEnableVertexAttribArray(ShaderAttribute::TRANSFORM + column);
+		glVertexAttribPointer(ShaderAttribute::TRANSFORM + column, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4), reinterpret_cast<const void*>(offset));
+		glVertexAttribDivisor(ShaderAttribute::TRANSFORM + column, 1);
+	}
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void InstanceRenderer::End()
+{
+	// The attributes live in the mesh vertex array, which is also drawn without instancing
+	for (GLuint column = 0; column < 4; ++column)
+		glDisableVertexAttribArray(ShaderAttribute::TRANSFORM + column);
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "GeometryPool.h"
+#include "ShaderCache.h"
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <vector>
+
+// Per-draw data of the shader pipeline. The world matrices of a view are uploaded
+// together and read by the programs as a per-instance attribute, so one draw, many
+// copies of a mesh, or on GL 4.3 whole buckets of meshes drawn with one indirect call
+// all find their transforms by instance index.
+class InstanceRenderer
+{
+public:
+	InstanceRenderer();
+	~InstanceRenderer();
+
+	// Called from the main context before the render thread starts, the buffers are
+	// shared with it. Returns false without GL 3.3, the renderer then draws one item at
+	// a time with the fixed function pipeline.
+	bool Init();
+	void Destroy();
+
+	bool IsAvailable() const { return instanceBuffer != 0; }
+	bool SupportsMultiDraw() const { return IsAvailable() && GLEW_VERSION_4_3; }
+
+	// Called once per view, before any of its instanced draws
+	void Upload(const std::vector<glm::mat4>& transforms);
+
+	// Leaves the command buffer bound to GL_DRAW_INDIRECT_BUFFER for the rest of the view
+	void UploadCommands(const std::vector<DrawElementsIndirectCommand>& commands);
+
+	// The mesh vertex array must be bound, the per-instance attributes are stored in it
+	void Begin(size_t firstInstance);
+	void End();
+
+private:
+	GLuint instanceBuffer = 0;
+	size_t bufferCapacity = 0;
+	GLuint commandBuffer = 0;
+	size_t commandCapacity = 0;
+	bool initialized = false;
+};
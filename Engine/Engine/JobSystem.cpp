@@ -0,0 +1,329 @@
+#include "JobSystem.h"
+
+#include "Logger.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace
+{
+	thread_local int currentWorker = -1;
+}
+
+JobSystem::JobSystem() : mainThreadId(std::this_thread::get_id())
+{
+}
+
+JobSystem::~JobSystem()
+{
+	Stop();
+}
+
+int JobSystem::GetDefaultWorkerCount()
+{
+	const int hardwareThreads = static_cast<int>(std::thread::hardware_concurrency());
+	return (std::max)(1, hardwareThreads - 1);
+}
+
+void JobSystem::Start(int workerCount)
+{
+	if (running)
+		Stop();
+
+	if (workerCount <= 0)
+		workerCount = GetDefaultWorkerCount();
+
+	mainThreadId = std::this_thread::get_id();
+	stopping = false;
+
+	workers.clear();
+	for (int i = 0; i < workerCount; ++i)
+		workers.push_back(std::make_unique<Worker>());
+
+	for (int i = 0; i < workerCount; ++i)
+		workers[i]->thread = std::thread(&JobSystem::WorkerLoop, this, i);
+
+	// Published once the workers exist, Submit reads it from any thread
+	running.store(true, std::memory_order_release);
+
+	lastSample = std::chrono::steady_clock::now();
+
+	LOG(LogType::LOG_INFO, "Job system started with %d worker threads", workerCount);
+}
+
+void JobSystem::Stop()
+{
+	if (!running)
+		return;
+
+	// Let queued work drain so nobody waits on a counter forever
+	while (queuedTasks.load() > 0)
+		RunOneTask(-1);
+
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex);
+		stopping = true;
+	}
+	sleepCondition.notify_all();
+
+	for (auto& worker : workers)
+	{
+		if (worker->thread.joinable())
+			worker->thread.join();
+	}
+
+	running.store(false, std::memory_order_release);
+	workers.clear();
+
+	RunMainThreadJobs();
+}
+
+void JobSystem::Submit(Job job, JobCounter* counter)
+{
+	if (counter != nullptr)
+		counter->pending.fetch_add(1, std::memory_order_acq_rel);
+
+	Task task;
+	task.job = std::move(job);
+	task.counter = counter;
+
+	if (!running)
+	{
+		Execute(task);
+		return;
+	}
+
+	Push(std::move(task));
+}
+
+void JobSystem::SubmitAfter(JobCounter& dependency, Job job, JobCounter* counter)
+{
+	if (counter != nullptr)
+		counter->pending.fetch_add(1, std::memory_order_acq_rel);
+
+	// The extra reference taken above is handed to the continuation
+	auto continuation = [this, job = std::move(job), counter]() mutable
+		{
+			Submit(std::move(job), counter);
+			if (counter != nullptr)
+				Finish(counter);
+		};
+
+	{
+		std::lock_guard<std::mutex> lock(dependency.continuationMutex);
+		if (!dependency.IsDone())
+		{
+			dependency.continuations.push_back(std::move(continuation));
+			return;
+		}
+	}
+
+	continuation();
+}
+
+void JobSystem::SubmitMainThread(Job job, JobCounter* counter)
+{
+	if (counter != nullptr)
+		counter->pending.fetch_add(1, std::memory_order_acq_rel);
+
+	Task task;
+	task.job = std::move(job);
+	task.counter = counter;
+
+	std::lock_guard<std::mutex> lock(mainThreadMutex);
+	mainThreadTasks.push_back(std::move(task));
+}
+
+void JobSystem::ParallelFor(size_t count, size_t batchSize, const std::function<void(size_t begin, size_t end)>& func)
+{
+	if (count == 0)
+		return;
+
+	batchSize = (std::max)(batchSize, static_cast<size_t>(1));
+
+	if (!running || count <= batchSize)
+	{
+		func(0, count);
+		return;
+	}
+
+	JobCounter counter;
+	for (size_t begin = 0; begin < count; begin += batchSize)
+	{
+		const size_t end = (std::min)(begin + batchSize, count);
+		Submit([&func, begin, end]() { func(begin, end); }, &counter);
+	}
+
+	Wait(counter);
+}
+
+void JobSystem::Wait(JobCounter& counter)
+{
+	while (!counter.IsDone())
+	{
+		if (IsMainThread())
+			RunMainThreadJobs();
+
+		if (!RunOneTask(currentWorker))
+			std::this_thread::yield();
+	}
+
+	std::lock_guard<std::mutex> lock(counter.continuationMutex);
+}
+
+size_t JobSystem::RunMainThreadJobs()
+{
+	size_t executed = 0;
+
+	while (true)
+	{
+		Task task;
+		{
+			std::lock_guard<std::mutex> lock(mainThreadMutex);
+			if (mainThreadTasks.empty())
+				return executed;
+
+			task = std::move(mainThreadTasks.front());
+			mainThreadTasks.pop_front();
+		}
+
+		Execute(task);
+		executed++;
+	}
+}
+
+void JobSystem::SampleUtilization()
+{
+	const auto now = std::chrono::steady_clock::now();
+	const double elapsedNs = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(now - lastSample).count());
+	lastSample = now;
+
+	if (elapsedNs <= 0.0)
+		return;
+
+	for (auto& worker : workers)
+	{
+		const uint64_t busy = worker->busyNs.exchange(0, std::memory_order_relaxed);
+		worker->utilization = static_cast<float>((std::min)(1.0, busy / elapsedNs));
+	}
+}
+
+void JobSystem::WorkerLoop(int index)
+{
+	currentWorker = index;
+
+	while (true)
+	{
+		if (RunOneTask(index))
+			continue;
+
+		std::unique_lock<std::mutex> lock(sleepMutex);
+		sleepCondition.wait(lock, [this]() { return stopping.load() || queuedTasks.load() > 0; });
+
+		if (stopping && queuedTasks.load() == 0)
+			break;
+	}
+
+	currentWorker = -1;
+}
+
+void JobSystem::Push(Task task)
+{
+	// Workers push to their own deque, other threads spread tasks round-robin
+	const int index = currentWorker >= 0 ? currentWorker : static_cast<int>(nextWorker.fetch_add(1) % workers.size());
+
+	{
+		std::lock_guard<std::mutex> lock(workers[index]->mutex);
+		workers[index]->tasks.push_back(std::move(task));
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex);
+		queuedTasks.fetch_add(1);
+	}
+	sleepCondition.notify_one();
+}
+
+bool JobSystem::PopOrSteal(int index, Task& task)
+{
+	// Own work is taken LIFO for locality, stolen work FIFO
+	if (index >= 0)
+	{
+		Worker& own = *workers[index];
+		std::lock_guard<std::mutex> lock(own.mutex);
+		if (!own.tasks.empty())
+		{
+			task = std::move(own.tasks.back());
+			own.tasks.pop_back();
+			return true;
+		}
+	}
+
+	const int count = static_cast<int>(workers.size());
+	const int start = index >= 0 ? index + 1 : 0;
+	for (int i = 0; i < count; ++i)
+	{
+		const int victim = (start + i) % count;
+		if (victim == index)
+			continue;
+
+		Worker& other = *workers[victim];
+		std::lock_guard<std::mutex> lock(other.mutex);
+		if (!other.tasks.empty())
+		{
+			task = std::move(other.tasks.front());
+			other.tasks.pop_front();
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool JobSystem::RunOneTask(int index)
+{
+	Task task;
+	if (!PopOrSteal(index, task))
+		return false;
+
+	queuedTasks.fetch_sub(1);
+
+	const auto start = std::chrono::steady_clock::now();
+	Execute(task);
+	const auto end = std::chrono::steady_clock::now();
+
+	if (index >= 0)
+	{
+		Worker& worker = *workers[index];
+		worker.busyNs.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count(), std::memory_order_relaxed);
+		worker.jobsExecuted.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	return true;
+}
+
+void JobSystem::Execute(Task& task)
+{
+	task.job();
+	Finish(task.counter);
+}
+
+void JobSystem::Finish(JobCounter* counter)
+{
+	if (counter == nullptr)
+		return;
+
+	// The counter is only touched under its lock, Wait takes the same lock before
+	// returning so the owner can safely destroy it afterwards
+	std::vector<std::function<void()>> continuations;
+	{
+		std::lock_guard<std::mutex> lock(counter->continuationMutex);
+		if (counter->pending.fetch_sub(1, std::memory_order_acq_rel) != 1)
+			return;
+
+		continuations.swap(counter->continuations);
+	}
+
+	for (auto& continuation : continuations)
+		continuation();
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class JobSystem;
+
+// Counts jobs still running. Continuations queued with JobSystem::SubmitAfter run
+// once the counter drops back to zero.
+class JobCounter
+{
+public:
+	bool IsDone() const { return pending.load(std::memory_order_acquire) == 0; }
+
+private:
+	friend class JobSystem;
+
+	std::atomic<int> pending{ 0 };
+	std::mutex continuationMutex;
+	std::vector<std::function<void()>> continuations;
+};
+
+class JobSystem
+{
+public:
+	typedef std::function<void()> Job;
+
+	JobSystem();
+	~JobSystem();
+
+	// Main thread only, and only while nothing else can submit: no job may be in
+	// flight on any thread. Stop runs what is still queued before joining the workers.
+	void Start(int workerCount = 0);
+	void Stop();
+
+	void Submit(Job job, JobCounter* counter = nullptr);
+	void SubmitAfter(JobCounter& dependency, Job job, JobCounter* counter = nullptr);
+	void SubmitMainThread(Job job, JobCounter* counter = nullptr);
+
+	// Splits [0, count) in batches and blocks until every batch has run
+	void ParallelFor(size_t count, size_t batchSize, const std::function<void(size_t begin, size_t end)>& func);
+
+	// The calling thread keeps running jobs while it waits
+	void Wait(JobCounter& counter);
+
+	size_t RunMainThreadJobs();
+	void SampleUtilization();
+
+	bool IsRunning() const { return running.load(std::memory_order_acquire); }
+	bool IsMainThread() const { return std::this_thread::get_id() == mainThreadId; }
+	int GetWorkerCount() const { return static_cast<int>(workers.size()); }
+	float GetWorkerUtilization(int worker) const { return workers[worker]->utilization; }
+	uint64_t GetWorkerJobCount(int worker) const { return workers[worker]->jobsExecuted.load(std::memory_order_relaxed); }
+
+	static int GetDefaultWorkerCount();
+
+private:
+	struct Task
+	{
+		Job job;
+		JobCounter* counter = nullptr;
+	};
+
+	struct Worker
+	{
+		std::mutex mutex;
+		std::deque<Task> tasks;
+		std::thread thread;
+
+		std::atomic<uint64_t> busyNs{ 0 };
+		std::atomic<uint64_t> jobsExecuted{ 0 };
+		float utilization = 0.0f;
+	};
+
+	void WorkerLoop(int index);
+	void Push(Task task);
+	bool PopOrSteal(int index, Task& task);
+	bool RunOneTask(int index);
+	void Execute(Task& task);
+	void Finish(JobCounter* counter);
+
+private:
+	std::vector<std::unique_ptr<Worker>> workers;
+
+	std::mutex mainThreadMutex;
+	std::deque<Task> mainThreadTasks;
+
+	std::mutex sleepMutex;
+	std::condition_variable sleepCondition;
+	std::atomic<int> queuedTasks{ 0 };
+	std::atomic<uint32_t> nextWorker{ 0 };
+
+	std::thread::id mainThreadId;
+	std::atomic<bool> running{ false };
+	std::atomic<bool> stopping{ false };
+
+	std::chrono::steady_clock::time_point lastSample;
+};
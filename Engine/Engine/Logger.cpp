@@ -6,9 +6,9 @@ Logger logger;
 
 void Logger::Log(const char file[], int line, LogType type, const char* format, ...)
 {
-	static char tmpString1[4096];
-	static char tmpString2[4096];
-	static va_list ap;
+	char tmpString1[4096];
+	char tmpString2[4096];
+	va_list ap;
 
 	const char* filename = strrchr(file, '\\');
 	if (!filename) {
@@ -28,10 +28,13 @@ void Logger::Log(const char file[], int line, LogType type, const char* format,
 void Logger::AddLog(LogType type, std::string message)
 {
 	message.erase(std::remove(message.begin(), message.end(), '\n'), message.end());
+
+	std::lock_guard<std::mutex> lock(logsMutex);
 	logs.push_back({ type, message });
 }
 
 void Logger::Clear()
 {
+	std::lock_guard<std::mutex> lock(logsMutex);
 	logs.clear();
 }
\ No newline at end of file
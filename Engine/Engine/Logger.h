@@ -1,5 +1,6 @@
 #pragma once
 
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -25,10 +26,15 @@ public:
 	void AddLog(LogType type, std::string message);
 	void Clear();
 
-	const std::vector<LogInfo> GetLogs() const { return logs; }
+	const std::vector<LogInfo> GetLogs() const
+	{
+		std::lock_guard<std::mutex> lock(logsMutex);
+		return logs;
+	}
 
 private:
 	std::vector<LogInfo> logs;
+	mutable std::mutex logsMutex;
 };
 
 extern Logger logger;
\ No newline at end of file
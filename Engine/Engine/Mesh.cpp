@@ -1,30 +1,39 @@
 #include "Mesh.h"
 #include <glm/gtc/type_ptr.hpp>
 
-void Mesh::InitMesh()
+#include <algorithm>
+#include <cstring>
+
+void Mesh::InitMesh(bool uploadBuffers)
 {
-	//Vertices
-	glGenBuffers(1, (GLuint*)&(verticesId));
-	glBindBuffer(GL_ARRAY_BUFFER, verticesId);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(float) * verticesCount * 3, vertices, GL_STATIC_DRAW);
+	if (uploadBuffers && verticesCount > 0 && indicesCount > 0)
+	{
+		std::vector<float> interleaved(static_cast<size_t>(verticesCount) * GeometryPool::VERTEX_FLOATS, 0.0f);
+		for (uint i = 0; i < verticesCount; ++i)
+		{
+			float* vertex = &interleaved[static_cast<size_t>(i) * GeometryPool::VERTEX_FLOATS];
+			memcpy(vertex, &vertices[i * 3], sizeof(float) * 3);
 
-	//Indices
-	glGenBuffers(1, (GLuint*)&(indicesId));
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indicesId);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(uint) * indicesCount, indices, GL_STATIC_DRAW);
+			if (i < normalsCount)
+				memcpy(vertex + 3, &normals[i * 3], sizeof(float) * 3);
 
-	//Normals
-	glGenBuffers(1, (GLuint*)&(normalsId));
-	glBindBuffer(GL_ARRAY_BUFFER, normalsId);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(float) * normalsCount * 3, &normals[0], GL_STATIC_DRAW);
+			if (i < texCoordsCount)
+				memcpy(vertex + 6, &texCoords[i * 2], sizeof(float) * 2);
+		}
 
-	//Texture Coords
-	glGenBuffers(1, (GLuint*)&(texCoordsId));
-	glBindBuffer(GL_ARRAY_BUFFER, texCoordsId);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(float) * texCoordsCount * 2, &texCoords[0], GL_STATIC_DRAW);
+		if (lods.empty())
+		{
+			geometry = GeometryPool::Get().Allocate(interleaved.data(), verticesCount, indices, indicesCount);
+		}
+		else
+		{
+			std::vector<uint> allIndices(indices, indices + indicesCount);
+			allIndices.insert(allIndices.end(), lodIndices.begin(), lodIndices.end());
+			geometry = GeometryPool::Get().Allocate(interleaved.data(), verticesCount, allIndices.data(), static_cast<uint>(allIndices.size()));
+		}
+	}
 
-	glBindBuffer(GL_ARRAY_BUFFER, 0);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+	meshletBounds.Build(meshlets);
 
 	if (vertices != nullptr && verticesCount > 0)
 	{
@@ -45,77 +54,36 @@ void Mesh::InitMesh()
 	}
 }
 
-void Mesh::DrawMesh(GLuint textureID, bool drawTextures, bool wireframe, bool shadedWireframe) const
+GeometryAllocation Mesh::GetLodGeometry(uint lod) const
 {
-	if (!shadedWireframe)
-		glPolygonMode(GL_FRONT_AND_BACK, wireframe ? GL_LINE : GL_FILL);
-	else
-		glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-
-	glColor3f(diffuseColor.x, diffuseColor.y, diffuseColor.z);
+	GeometryAllocation allocation = geometry;
+	allocation.indexCount = GetLodIndexCount(lod);
+	if (lod > 0)
+		allocation.firstIndex += indicesCount + lods[lod - 1].firstIndex;
 
-	if (drawTextures && !wireframe && textureID != 0)
-	{
-		glBindTexture(GL_TEXTURE_2D, textureID);
-		glEnableClientState(GL_TEXTURE_COORD_ARRAY);
-		glBindBuffer(GL_ARRAY_BUFFER, texCoordsId);
-		glTexCoordPointer(2, GL_FLOAT, 0, nullptr);
-	}
-	else
-	{
-		glDisableClientState(GL_TEXTURE_COORD_ARRAY);
-	}
-
-	glEnableClientState(GL_VERTEX_ARRAY);
-	glBindBuffer(GL_ARRAY_BUFFER, verticesId);
-	glVertexPointer(3, GL_FLOAT, 0, nullptr);
-
-	if (normalsCount > 0)
-	{
-		glEnableClientState(GL_NORMAL_ARRAY);
-		glBindBuffer(GL_ARRAY_BUFFER, normalsId);
-		glNormalPointer(GL_FLOAT, 0, nullptr);
-	}
-	else
-	{
-		glDisableClientState(GL_NORMAL_ARRAY);
-	}
-
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indicesId);
-	glDrawElements(GL_TRIANGLES, indicesCount, GL_UNSIGNED_INT, nullptr);
-
-	glBindTexture(GL_TEXTURE_2D, 0);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-	glBindBuffer(GL_ARRAY_BUFFER, 0);
-	glDisableClientState(GL_VERTEX_ARRAY);
-	glDisableClientState(GL_NORMAL_ARRAY);
-	glDisableClientState(GL_TEXTURE_COORD_ARRAY);
-
-	if (shadedWireframe)
-	{
-		glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-
-		glPushAttrib(GL_ALL_ATTRIB_BITS);
-		glColor3f(0.0f, 1.0f, 0.0f);
+	return allocation;
+}
 
-		glEnableClientState(GL_VERTEX_ARRAY);
-		glBindBuffer(GL_ARRAY_BUFFER, verticesId);
-		glVertexPointer(3, GL_FLOAT, 0, nullptr);
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indicesId);
-		glDrawElements(GL_TRIANGLES, indicesCount, GL_UNSIGNED_INT, nullptr);
+uint Mesh::SelectLod(float screenRadius, uint currentLod) const
+{
+	uint lod = (std::min)(currentLod, GetLodCount() - 1);
 
-		glPopAttrib();
+	while (lod > 0 && lods[lod - 1].error * screenRadius > LOD_PIXEL_ERROR)
+		--lod;
 
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
-		glDisableClientState(GL_VERTEX_ARRAY);
-	}
+	while (lod < lods.size() && lods[lod].error * screenRadius < LOD_PIXEL_ERROR * LOD_HYSTERESIS)
+		++lod;
 
-	glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+	return lod;
 }
 
-void Mesh::DrawOutline(bool parentSelected) const
+void Mesh::DrawOutline(RenderStateCache& state, bool parentSelected) const
 {
+	if (!IsUploaded())
+		return;
+
+	const GeometryAllocation outline = GetLodGeometry(0);
+
 	glEnable(GL_STENCIL_TEST);
 
 	glStencilFunc(GL_ALWAYS, 1, 0xFFFFFFFF);
@@ -124,12 +92,11 @@ void Mesh::DrawOutline(bool parentSelected) const
 	glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
 	glDisable(GL_DEPTH_TEST);
 
-	glEnableClientState(GL_VERTEX_ARRAY);
-	glBindBuffer(GL_ARRAY_BUFFER, verticesId);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indicesId);
-	glVertexPointer(3, GL_FLOAT, 0, nullptr);
+	state.SetPolygonMode(GL_FILL);
+	state.BindTexture(0);
+	state.BindVertexArray(geometry.page->GetVertexArray());
 
-	glDrawElements(GL_TRIANGLES, indicesCount, GL_UNSIGNED_INT, nullptr);
+	state.DrawElements(outline);
 
 	glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
 	glEnable(GL_DEPTH_TEST);
@@ -137,39 +104,41 @@ void Mesh::DrawOutline(bool parentSelected) const
 	glStencilFunc(GL_NOTEQUAL, 1, 0xFFFFFFFF);
 	glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
 
-	glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+	state.SetPolygonMode(GL_LINE);
+	state.SetColor(parentSelected ? glm::vec3(0.4f, 0.6f, 0.6f) : glm::vec3(0.0f, 1.0f, 1.0f));
 	glLineWidth(4.0f);
-	parentSelected ? glColor3f(0.4f, 0.6f, 0.6f) : glColor3f(0.0f, 1.0f, 1.0f);
 
-	glDrawElements(GL_TRIANGLES, indicesCount, GL_UNSIGNED_INT, nullptr);
+	state.DrawElements(outline);
 
 	glDisable(GL_STENCIL_TEST);
 	glLineWidth(1.0f);
-	glColor3f(1.0f, 1.0f, 1.0f);
 }
 
-void Mesh::DrawNormals(bool vertexNormals, bool faceNormals, float vertexNormalLength, float faceNormalLength, glm::vec3 vertexNormalColor, glm::vec3 faceNormalColor) const
+void Mesh::AddNormals(DebugDrawList& list, const glm::mat4& transform, bool vertexNormals, bool faceNormals, float vertexNormalLength, float faceNormalLength, glm::vec3 vertexNormalColor, glm::vec3 faceNormalColor) const
 {
+	// Lines are drawn in world space, both ends are transformed so the length scales with the object
 	if (vertexNormals && verticesCount > 0 && normalsCount > 0)
 	{
-		glColor3f(vertexNormalColor.x, vertexNormalColor.y, vertexNormalColor.z);
-		glBegin(GL_LINES);
+		const uint32_t color = DebugDrawList::PackColor(glm::vec4(vertexNormalColor, 1.0f));
+		std::vector<DebugVertex>& lines = list.GetLines(1.0f);
+		lines.reserve(lines.size() + verticesCount * 2);
+
 		for (size_t i = 0; i < verticesCount; i++)
 		{
-			glVertex3f(vertices[i * 3], vertices[i * 3 + 1], vertices[i * 3 + 2]);
-			glVertex3f(vertices[i * 3] + normals[i * 3] * vertexNormalLength,
-				vertices[i * 3 + 1] + normals[i * 3 + 1] * vertexNormalLength,
-				vertices[i * 3 + 2] + normals[i * 3 + 2] * vertexNormalLength
-			);
+			const glm::vec3 vertex(vertices[i * 3], vertices[i * 3 + 1], vertices[i * 3 + 2]);
+			const glm::vec3 normal(normals[i * 3], normals[i * 3 + 1], normals[i * 3 + 2]);
+
+			lines.push_back({ glm::vec3(transform * glm::vec4(vertex, 1.0f)), color });
+			lines.push_back({ glm::vec3(transform * glm::vec4(vertex + normal * vertexNormalLength, 1.0f)), color });
 		}
-		glEnd();
 	}
 
 	if (faceNormals && indicesCount > 0)
 	{
-		glColor3f(faceNormalColor.x, faceNormalColor.y, faceNormalColor.z);
+		const uint32_t color = DebugDrawList::PackColor(glm::vec4(faceNormalColor, 1.0f));
+		std::vector<DebugVertex>& lines = list.GetLines(1.0f);
+		lines.reserve(lines.size() + (indicesCount / 3) * 2);
 
-		glBegin(GL_LINES);
 		for (size_t i = 0; i < indicesCount; i += 3)
 		{
 			uint index0 = indices[i];
@@ -189,24 +158,15 @@ void Mesh::DrawNormals(bool vertexNormals, bool faceNormals, float vertexNormalL
 
 			glm::vec3 faceCenter = (v0 + v1 + v2) / 3.0f;
 
-			glVertex3f(faceCenter.x, faceCenter.y, faceCenter.z);
-			glVertex3f(faceCenter.x + normal.x * faceNormalLength,
-				faceCenter.y + normal.y * faceNormalLength,
-				faceCenter.z + normal.z * faceNormalLength
-			);
+			lines.push_back({ glm::vec3(transform * glm::vec4(faceCenter, 1.0f)), color });
+			lines.push_back({ glm::vec3(transform * glm::vec4(faceCenter + normal * faceNormalLength, 1.0f)), color });
 		}
-		glEnd();
 	}
-
-	glColor3f(1.0f, 1.0f, 1.0f);
 }
 
 void Mesh::CleanUpMesh()
 {
-	glDeleteBuffers(1, &verticesId);
-	glDeleteBuffers(1, &indicesId);
-	glDeleteBuffers(1, &normalsId);
-	glDeleteBuffers(1, &texCoordsId);
+	GeometryPool::Get().Free(geometry);
 
 	delete[] vertices;
 	delete[] indices;
@@ -218,6 +178,11 @@ void Mesh::CleanUpMesh()
 	normals = nullptr;
 	texCoords = nullptr;
 
+	lodIndices.clear();
+	lods.clear();
+	meshlets.clear();
+	meshletBounds.Clear();
+
 	if (parentModel)
 	{
 		parentModel->DeleteMesh(this);
@@ -225,109 +190,14 @@ void Mesh::CleanUpMesh()
 	}
 }
 
-void Mesh::DrawAABB(const glm::mat4& modelTransform) const
+void Mesh::AddAABB(DebugDrawList& list, const glm::mat4& transform) const
 {
-	AABB transformedAABB = GetAABB(modelTransform);
-
-	glPushAttrib(GL_ALL_ATTRIB_BITS);
-
-	glLineWidth(2.0f);
-	glColor3f(0.0f, 1.0f, 0.0f);
-
-	glBegin(GL_LINES);
-
-	glVertex3f(transformedAABB.min.x, transformedAABB.min.y, transformedAABB.min.z);
-	glVertex3f(transformedAABB.max.x, transformedAABB.min.y, transformedAABB.min.z);
-
-	glVertex3f(transformedAABB.max.x, transformedAABB.min.y, transformedAABB.min.z);
-	glVertex3f(transformedAABB.max.x, transformedAABB.min.y, transformedAABB.max.z);
-
-	glVertex3f(transformedAABB.max.x, transformedAABB.min.y, transformedAABB.max.z);
-	glVertex3f(transformedAABB.min.x, transformedAABB.min.y, transformedAABB.max.z);
-
-	glVertex3f(transformedAABB.min.x, transformedAABB.min.y, transformedAABB.max.z);
-	glVertex3f(transformedAABB.min.x, transformedAABB.min.y, transformedAABB.min.z);
-
-	glVertex3f(transformedAABB.min.x, transformedAABB.max.y, transformedAABB.min.z);
-	glVertex3f(transformedAABB.max.x, transformedAABB.max.y, transformedAABB.min.z);
-
-	glVertex3f(transformedAABB.max.x, transformedAABB.max.y, transformedAABB.min.z);
-	glVertex3f(transformedAABB.max.x, transformedAABB.max.y, transformedAABB.max.z);
-
-	glVertex3f(transformedAABB.max.x, transformedAABB.max.y, transformedAABB.max.z);
-	glVertex3f(transformedAABB.min.x, transformedAABB.max.y, transformedAABB.max.z);
-
-	glVertex3f(transformedAABB.min.x, transformedAABB.max.y, transformedAABB.max.z);
-	glVertex3f(transformedAABB.min.x, transformedAABB.max.y, transformedAABB.min.z);
-
-	glVertex3f(transformedAABB.min.x, transformedAABB.min.y, transformedAABB.min.z);
-	glVertex3f(transformedAABB.min.x, transformedAABB.max.y, transformedAABB.min.z);
-
-	glVertex3f(transformedAABB.max.x, transformedAABB.min.y, transformedAABB.min.z);
-	glVertex3f(transformedAABB.max.x, transformedAABB.max.y, transformedAABB.min.z);
-
-	glVertex3f(transformedAABB.max.x, transformedAABB.min.y, transformedAABB.max.z);
-	glVertex3f(transformedAABB.max.x, transformedAABB.max.y, transformedAABB.max.z);
-
-	glVertex3f(transformedAABB.min.x, transformedAABB.min.y, transformedAABB.max.z);
-	glVertex3f(transformedAABB.min.x, transformedAABB.max.y, transformedAABB.max.z);
-
-	glEnd();
-
-	glPopAttrib();
+	const AABB transformedAABB = GetAABB(transform);
+	list.AddAABB(transformedAABB.min, transformedAABB.max, glm::vec4(0.0f, 1.0f, 0.0f, 1.0f), 2.0f);
 }
 
-void Mesh::DrawOBB(const glm::mat4& transform)
+void Mesh::AddOBB(DebugDrawList& list, const glm::mat4& transform) const
 {
-	OBB transformedOBB = GetOBB(transform);
-
-	glPushAttrib(GL_ALL_ATTRIB_BITS);
-
-	glLineWidth(2.0f);
-	glColor3f(1.0f, 0.0f, 0.0f);
-
-	glBegin(GL_LINES);
-
-	// Bottom face
-	glVertex3fv(glm::value_ptr(transformedOBB.vertices[0]));
-	glVertex3fv(glm::value_ptr(transformedOBB.vertices[4]));
-
-	glVertex3fv(glm::value_ptr(transformedOBB.vertices[4]));
-	glVertex3fv(glm::value_ptr(transformedOBB.vertices[5]));
-
-	glVertex3fv(glm::value_ptr(transformedOBB.vertices[5]));
-	glVertex3fv(glm::value_ptr(transformedOBB.vertices[1]));
-
-	glVertex3fv(glm::value_ptr(transformedOBB.vertices[1]));
-	glVertex3fv(glm::value_ptr(transformedOBB.vertices[0]));
-
-	// Top face
-	glVertex3fv(glm::value_ptr(transformedOBB.vertices[2]));
-	glVertex3fv(glm::value_ptr(transformedOBB.vertices[6]));
-
-	glVertex3fv(glm::value_ptr(transformedOBB.vertices[6]));
-	glVertex3fv(glm::value_ptr(transformedOBB.vertices[7]));
-
-	glVertex3fv(glm::value_ptr(transformedOBB.vertices[7]));
-	glVertex3fv(glm::value_ptr(transformedOBB.vertices[3]));
-
-	glVertex3fv(glm::value_ptr(transformedOBB.vertices[3]));
-	glVertex3fv(glm::value_ptr(transformedOBB.vertices[2]));
-
-	// Vertical edges
-	glVertex3fv(glm::value_ptr(transformedOBB.vertices[0]));
-	glVertex3fv(glm::value_ptr(transformedOBB.vertices[2]));
-
-	glVertex3fv(glm::value_ptr(transformedOBB.vertices[4]));
-	glVertex3fv(glm::value_ptr(transformedOBB.vertices[6]));
-
-	glVertex3fv(glm::value_ptr(transformedOBB.vertices[5]));
-	glVertex3fv(glm::value_ptr(transformedOBB.vertices[7]));
-
-	glVertex3fv(glm::value_ptr(transformedOBB.vertices[1]));
-	glVertex3fv(glm::value_ptr(transformedOBB.vertices[3]));
-
-	glEnd();
-
-	glPopAttrib();
+	const OBB transformedOBB = GetOBB(transform);
+	list.AddBox(transformedOBB.vertices.data(), glm::vec4(1.0f, 0.0f, 0.0f, 1.0f), 2.0f);
 }
\ No newline at end of file
@@ -6,8 +6,13 @@
 #include <glm/glm.hpp>
 #include <string>
 #include <array>
+#include <vector>
 
 #include "Model.h"
+#include "RenderState.h"
+#include "GeometryPool.h"
+#include "Meshlet.h"
+#include "DebugDraw.h"
 
 typedef unsigned int uint;
 
@@ -72,40 +77,69 @@ struct OBB
 	}
 };
 
+// A simplified level of detail, indexing the same vertices as the full mesh
+struct MeshLod
+{
+	uint firstIndex = 0;	// Into lodIndices
+	uint indexCount = 0;
+	float error = 0.0f;		// Relative to the radius of the mesh bounds
+};
+
 class Mesh : public Resource
 {
 public:
 	Mesh() : Resource(ResourceType::MESH) {}
 	~Mesh() { CleanUpMesh(); }
-	void InitMesh();
-	void DrawMesh(GLuint textureID, bool drawTextures, bool wireframe, bool shadedWireframe) const;
-	void DrawNormals(bool vertexNormals, bool faceNormals, float vertexNormalLength, float faceNormalLength, glm::vec3 vertexNormalColor, glm::vec3 faceNormalColor) const;
-	void DrawOutline(bool parentSelected) const;
+	void InitMesh(bool uploadBuffers = true);
+	void AddNormals(DebugDrawList& list, const glm::mat4& transform, bool vertexNormals, bool faceNormals, float vertexNormalLength, float faceNormalLength, glm::vec3 vertexNormalColor, glm::vec3 faceNormalColor) const;
+	void DrawOutline(RenderStateCache& state, bool parentSelected) const;
 	void CleanUpMesh();
 
 	const AABB& GetAABB() const { return aabb; }
 	AABB GetAABB(const glm::mat4& transform) const { return aabb.Transformed(transform); }
-	OBB GetOBB(const glm::mat4& transform) { return { transform, GetAABB() }; }
+	OBB GetOBB(const glm::mat4& transform) const { return { transform, GetAABB() }; }
 
-	void DrawAABB(const glm::mat4& transform) const;
-	void DrawOBB(const glm::mat4& transform);
+	void AddAABB(DebugDrawList& list, const glm::mat4& transform) const;
+	void AddOBB(DebugDrawList& list, const glm::mat4& transform) const;
 
 	void SetParentModel(Model* model) { parentModel = model; }
 
+	bool IsUploaded() const { return geometry.page != nullptr; }
+
+	// Headless runs keep the geometry on the CPU only, it is still recorded as drawn
+	bool HasGeometry() const { return verticesCount > 0 && indicesCount > 0; }
+
+	// Level 0 is the full mesh
+	uint GetLodCount() const { return static_cast<uint>(lods.size()) + 1; }
+	uint GetLodIndexCount(uint lod) const { return lod == 0 ? indicesCount : lods[lod - 1].indexCount; }
+	GeometryAllocation GetLodGeometry(uint lod) const;
+
+	// Coarsest level whose error stays under LOD_PIXEL_ERROR pixels for bounds covering
+	// screenRadius pixels. Coarser levels are only taken once well under it, so an object
+	// sitting at a threshold does not pop back and forth.
+	uint SelectLod(float screenRadius, uint currentLod) const;
+
 public:
-	uint indicesId = 0;
+	// Position, normal and texture coordinates of each vertex, interleaved in the pool
+	GeometryAllocation geometry;
+
 	uint indicesCount = 0;
 	uint* indices = nullptr;
-	uint verticesId = 0;
 	uint verticesCount = 0;
 	float* vertices = nullptr;
-	uint normalsId = 0;
 	uint normalsCount = 0;
 	float* normals = nullptr;
-	uint texCoordsId = 0;
 	uint texCoordsCount = 0;
 	float* texCoords = nullptr;
 
+	// Indices of every simplified level, uploaded after the full ones
+	std::vector<uint> lodIndices;
+	std::vector<MeshLod> lods;
+
+	// Clusters of the full level, each one a contiguous range of indices
+	std::vector<Meshlet> meshlets;
+	MeshletBounds meshletBounds;
+
 	// Material properties
 	glm::vec4 diffuseColor = glm::vec4(1.0f);
 	glm::vec4 specularColor = glm::vec4(1.0f);
@@ -115,6 +149,9 @@ public:
 	AABB aabb = AABB();
 	OBB obb = OBB();
 
+	static constexpr float LOD_PIXEL_ERROR = 1.0f;
+	static constexpr float LOD_HYSTERESIS = 0.75f;
+
 private:
 	Model* parentModel = nullptr;
 };
\ No newline at end of file
@@ -0,0 +1,331 @@
+#include "MeshSimplifier.h"
+
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <functional>
+#include <numeric>
+#include <queue>
+#include <unordered_map>
+
+namespace
+{
+	// Sum of squared distances to a set of planes, weighted by the area of their triangles
+	struct Quadric
+	{
+		double a2 = 0.0, ab = 0.0, ac = 0.0, ad = 0.0;
+		double b2 = 0.0, bc = 0.0, bd = 0.0;
+		double c2 = 0.0, cd = 0.0;
+		double d2 = 0.0;
+		double weight = 0.0;
+
+		void AddPlane(const glm::dvec3& n, double d, double w)
+		{
+			a2 += n.x * n.x * w; ab += n.x * n.y * w; ac += n.x * n.z * w; ad += n.x * d * w;
+			b2 += n.y * n.y * w; bc += n.y * n.z * w; bd += n.y * d * w;
+			c2 += n.z * n.z * w; cd += n.z * d * w;
+			d2 += d * d * w;
+			weight += w;
+		}
+
+		void Add(const Quadric& other)
+		{
+			a2 += other.a2; ab += other.ab; ac += other.ac; ad += other.ad;
+			b2 += other.b2; bc += other.bc; bd += other.bd;
+			c2 += other.c2; cd += other.cd;
+			d2 += other.d2;
+			weight += other.weight;
+		}
+
+		// Mean squared distance from p to the planes
+		double Evaluate(const glm::vec3& p) const
+		{
+			if (weight <= 0.0)
+				return 0.0;
+
+			const double x = p.x, y = p.y, z = p.z;
+			const double error = a2 * x * x + 2.0 * ab * x * y + 2.0 * ac * x * z + 2.0 * ad * x
+				+ b2 * y * y + 2.0 * bc * y * z + 2.0 * bd * y
+				+ c2 * z * z + 2.0 * cd * z
+				+ d2;
+
+			return std::fabs(error) / weight;
+		}
+	};
+
+	struct Collapse
+	{
+		double cost;
+		uint32_t from;
+		uint32_t to;
+
+		bool operator>(const Collapse& other) const { return cost > other.cost; }
+	};
+
+	uint64_t EdgeKey(uint32_t a, uint32_t b)
+	{
+		return a < b ? (static_cast<uint64_t>(a) << 32) | b : (static_cast<uint64_t>(b) << 32) | a;
+	}
+}
+
+float MeshSimplifier::Simplify(const float* positions, const float* texCoords, uint32_t vertexCount,
+	const uint32_t* indices, uint32_t indexCount,
+	uint32_t targetIndexCount, float maxError, std::vector<uint32_t>& result)
+{
+	result.assign(indices, indices + indexCount - indexCount % 3);
+	if (vertexCount == 0 || result.size() <= targetIndexCount)
+		return 0.0f;
+
+	const auto position = [positions](uint32_t vertex) { return glm::vec3(positions[vertex * 3], positions[vertex * 3 + 1], positions[vertex * 3 + 2]); };
+
+	// Vertices split by normals or texture coordinates share a position, they collapse as one
+	std::vector<uint32_t> order(vertexCount);
+	std::iota(order.begin(), order.end(), 0);
+	std::sort(order.begin(), order.end(), [&position](uint32_t a, uint32_t b)
+		{
+			const glm::vec3 pa = position(a), pb = position(b);
+			if (pa.x != pb.x) return pa.x < pb.x;
+			if (pa.y != pb.y) return pa.y < pb.y;
+			return pa.z < pb.z;
+		});
+
+	std::vector<uint32_t> groupOf(vertexCount);
+	std::vector<glm::vec3> groupPosition;
+	std::vector<std::vector<uint32_t>> groupVertices;
+	glm::vec3 minPoint(FLT_MAX), maxPoint(-FLT_MAX);
+
+	for (size_t i = 0; i < order.size(); ++i)
+	{
+		const glm::vec3 p = position(order[i]);
+		if (i == 0 || p != groupPosition.back())
+		{
+			groupPosition.push_back(p);
+			groupVertices.emplace_back();
+		}
+
+		groupOf[order[i]] = static_cast<uint32_t>(groupPosition.size() - 1);
+		groupVertices.back().push_back(order[i]);
+		minPoint = glm::min(minPoint, p);
+		maxPoint = glm::max(maxPoint, p);
+	}
+
+	const float radius = glm::length(maxPoint - minPoint) * 0.5f;
+	if (radius <= 0.0f)
+		return 0.0f;
+
+	const double maxCost = static_cast<double>(maxError) * radius * static_cast<double>(maxError) * radius;
+
+	const uint32_t groupCount = static_cast<uint32_t>(groupPosition.size());
+	const uint32_t triangleCount = static_cast<uint32_t>(result.size() / 3);
+
+	std::vector<Quadric> quadrics(groupCount);
+	std::vector<std::vector<uint32_t>> groupTriangles(groupCount);
+	std::vector<bool> groupAlive(groupCount, true);
+	std::vector<bool> locked(groupCount, false);
+	std::vector<bool> triangleAlive(triangleCount, true);
+	std::unordered_map<uint64_t, uint32_t> edgeUses;
+	uint32_t liveTriangles = 0;
+
+	const auto corner = [&result, &groupOf](uint32_t triangle, int k) { return groupOf[result[triangle * 3 + k]]; };
+
+	for (uint32_t t = 0; t < triangleCount; ++t)
+	{
+		if (result[t * 3] >= vertexCount || result[t * 3 + 1] >= vertexCount || result[t * 3 + 2] >= vertexCount)
+		{
+			triangleAlive[t] = false;
+			continue;
+		}
+
+		const uint32_t g[3] = { corner(t, 0), corner(t, 1), corner(t, 2) };
+		if (g[0] == g[1] || g[1] == g[2] || g[0] == g[2])
+		{
+			triangleAlive[t] = false;
+			continue;
+		}
+
+		liveTriangles++;
+
+		const glm::dvec3 p0(groupPosition[g[0]]), p1(groupPosition[g[1]]), p2(groupPosition[g[2]]);
+		glm::dvec3 normal = glm::cross(p1 - p0, p2 - p0);
+		const double length = glm::length(normal);
+		if (length > 0.0)
+		{
+			normal /= length;
+			const double d = -glm::dot(normal, p0);
+			for (int k = 0; k < 3; ++k)
+				quadrics[g[k]].AddPlane(normal, d, length * 0.5);
+		}
+
+		for (int k = 0; k < 3; ++k)
+		{
+			groupTriangles[g[k]].push_back(t);
+			edgeUses[EdgeKey(g[k], g[(k + 1) % 3])]++;
+		}
+	}
+
+	// Collapsing border or non-manifold vertices would eat into the silhouette
+	for (const auto& edge : edgeUses)
+	{
+		if (edge.second != 2)
+		{
+			locked[static_cast<uint32_t>(edge.first >> 32)] = true;
+			locked[static_cast<uint32_t>(edge.first & 0xFFFFFFFF)] = true;
+		}
+	}
+
+	std::priority_queue<Collapse, std::vector<Collapse>, std::greater<Collapse>> queue;
+
+	const auto pushCollapses = [&](uint32_t from)
+		{
+			if (locked[from])
+				return;
+
+			for (uint32_t t : groupTriangles[from])
+			{
+				if (!triangleAlive[t])
+					continue;
+
+				for (int k = 0; k < 3; ++k)
+				{
+					const uint32_t to = corner(t, k);
+					if (to != from)
+						queue.push({ quadrics[from].Evaluate(groupPosition[to]), from, to });
+				}
+			}
+		};
+
+	for (uint32_t g = 0; g < groupCount; ++g)
+		pushCollapses(g);
+
+	std::vector<uint32_t> vertexRemap(vertexCount);
+	std::iota(vertexRemap.begin(), vertexRemap.end(), 0);
+	double appliedCost = 0.0;
+
+	while (liveTriangles * 3 > targetIndexCount && !queue.empty())
+	{
+		const Collapse collapse = queue.top();
+		queue.pop();
+
+		const uint32_t from = collapse.from;
+		const uint32_t to = collapse.to;
+		if (!groupAlive[from] || !groupAlive[to])
+			continue;
+
+		// Quadrics only grow, an outdated entry goes back with its real cost
+		const double cost = quadrics[from].Evaluate(groupPosition[to]);
+		if (cost > collapse.cost * 1.0001 + 1e-12)
+		{
+			queue.push({ cost, from, to });
+			continue;
+		}
+
+		if (cost > maxCost)
+			break;
+
+		// The edge must still exist, and no remaining triangle may flip or collapse to a sliver
+		bool connected = false;
+		bool flips = false;
+		for (uint32_t t : groupTriangles[from])
+		{
+			if (!triangleAlive[t])
+				continue;
+
+			const uint32_t g[3] = { corner(t, 0), corner(t, 1), corner(t, 2) };
+			if (g[0] == to || g[1] == to || g[2] == to)
+			{
+				connected = true;
+				continue;
+			}
+
+			glm::vec3 before[3], after[3];
+			for (int k = 0; k < 3; ++k)
+			{
+				before[k] = groupPosition[g[k]];
+				after[k] = g[k] == from ? groupPosition[to] : before[k];
+			}
+
+			const glm::vec3 normalBefore = glm::cross(before[1] - before[0], before[2] - before[0]);
+			const glm::vec3 normalAfter = glm::cross(after[1] - after[0], after[2] - after[0]);
+			const float lengths = glm::length(normalBefore) * glm::length(normalAfter);
+			if (lengths <= 0.0f || glm::dot(normalBefore, normalAfter) < 0.25f * lengths)
+			{
+				flips = true;
+				break;
+			}
+		}
+
+		if (!connected || flips)
+			continue;
+
+		// Every vertex of the collapsed position takes the target vertex whose texture
+		// coordinates are closest, which is the one across the edge away from seams
+		for (uint32_t vertex : groupVertices[from])
+		{
+			uint32_t best = groupVertices[to].front();
+			if (texCoords != nullptr)
+			{
+				float bestDistance = FLT_MAX;
+				for (uint32_t candidate : groupVertices[to])
+				{
+					const float du = texCoords[vertex * 2] - texCoords[candidate * 2];
+					const float dv = texCoords[vertex * 2 + 1] - texCoords[candidate * 2 + 1];
+					if (du * du + dv * dv < bestDistance)
+					{
+						bestDistance = du * du + dv * dv;
+						best = candidate;
+					}
+				}
+			}
+			vertexRemap[vertex] = best;
+		}
+
+		for (uint32_t t : groupTriangles[from])
+		{
+			if (!triangleAlive[t])
+				continue;
+
+			for (int k = 0; k < 3; ++k)
+			{
+				uint32_t& index = result[t * 3 + k];
+				if (groupOf[index] == from)
+					index = vertexRemap[index];
+			}
+
+			if (corner(t, 0) == corner(t, 1) || corner(t, 1) == corner(t, 2) || corner(t, 0) == corner(t, 2))
+			{
+				triangleAlive[t] = false;
+				liveTriangles--;
+			}
+			else
+			{
+				groupTriangles[to].push_back(t);
+			}
+		}
+
+		quadrics[to].Add(quadrics[from]);
+		groupAlive[from] = false;
+		groupTriangles[from].clear();
+
+		std::vector<uint32_t>& triangles = groupTriangles[to];
+		triangles.erase(std::remove_if(triangles.begin(), triangles.end(), [&triangleAlive](uint32_t t) { return !triangleAlive[t]; }), triangles.end());
+		std::sort(triangles.begin(), triangles.end());
+		triangles.erase(std::unique(triangles.begin(), triangles.end()), triangles.end());
+
+		appliedCost = (std::max)(appliedCost, cost);
+		pushCollapses(to);
+	}
+
+	size_t written = 0;
+	for (uint32_t t = 0; t < triangleCount; ++t)
+	{
+		if (!triangleAlive[t])
+			continue;
+
+		for (int k = 0; k < 3; ++k)
+			result[written++] = result[t * 3 + k];
+	}
+	result.resize(written);
+
+	return static_cast<float>(std::sqrt(appliedCost)) / radius;
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// Quadric error edge collapse. Vertices are only ever collapsed onto existing ones, so
+// the simplified triangles index the same vertex buffer as the full mesh. Vertices on
+// open borders are kept in place.
+namespace MeshSimplifier
+{
+	// Collapses edges until result holds at most targetIndexCount indices or the next
+	// collapse would move the surface further than maxError. texCoords may be null.
+	// Returns the error reached, both errors relative to the radius of the mesh bounds.
+	float Simplify(const float* positions, const float* texCoords, uint32_t vertexCount,
+		const uint32_t* indices, uint32_t indexCount,
+		uint32_t targetIndexCount, float maxError, std::vector<uint32_t>& result);
+}
@@ -0,0 +1,264 @@
+#include "Meshlet.h"
+
+#include <xmmintrin.h>
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+void MeshletBounds::Build(const std::vector<Meshlet>& meshlets)
+{
+	count = meshlets.size();
+	const size_t padded = (count + 3) & ~static_cast<size_t>(3);
+
+	std::vector<float>* arrays[8] = { &centerX, &centerY, &centerZ, &radius, &axisX, &axisY, &axisZ, &cutoff };
+	for (std::vector<float>* array : arrays)
+		array->assign(padded, 0.0f);
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		const Meshlet& meshlet = meshlets[i];
+		centerX[i] = meshlet.center.x;
+		centerY[i] = meshlet.center.y;
+		centerZ[i] = meshlet.center.z;
+		radius[i] = meshlet.radius;
+		axisX[i] = meshlet.coneAxis.x;
+		axisY[i] = meshlet.coneAxis.y;
+		axisZ[i] = meshlet.coneAxis.z;
+		cutoff[i] = meshlet.coneCutoff;
+	}
+}
+
+void MeshletBounds::Clear()
+{
+	std::vector<float>* arrays[8] = { &centerX, &centerY, &centerZ, &radius, &axisX, &axisY, &axisZ, &cutoff };
+	for (std::vector<float>* array : arrays)
+		array->clear();
+
+	count = 0;
+}
+
+static void ComputeBounds(const float* positions, const uint32_t* indices, Meshlet& meshlet)
+{
+	const auto position = [positions](uint32_t vertex) { return glm::vec3(positions[vertex * 3], positions[vertex * 3 + 1], positions[vertex * 3 + 2]); };
+
+	glm::vec3 minPoint(FLT_MAX), maxPoint(-FLT_MAX);
+	glm::vec3 normalSum(0.0f);
+
+	std::vector<glm::vec3> normals;
+	normals.reserve(meshlet.indexCount / 3);
+
+	for (uint32_t i = meshlet.firstIndex; i < meshlet.firstIndex + meshlet.indexCount; i += 3)
+	{
+		const glm::vec3 p0 = position(indices[i]), p1 = position(indices[i + 1]), p2 = position(indices[i + 2]);
+		minPoint = glm::min(minPoint, glm::min(p0, glm::min(p1, p2)));
+		maxPoint = glm::max(maxPoint, glm::max(p0, glm::max(p1, p2)));
+
+		const glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+		const float length = glm::length(normal);
+		if (length > 0.0f)
+		{
+			normals.push_back(normal / length);
+			normalSum += normals.back();
+		}
+	}
+
+	meshlet.center = (minPoint + maxPoint) * 0.5f;
+	meshlet.radius = 0.0f;
+	for (uint32_t i = meshlet.firstIndex; i < meshlet.firstIndex + meshlet.indexCount; ++i)
+		meshlet.radius = (std::max)(meshlet.radius, glm::length(position(indices[i]) - meshlet.center));
+
+	meshlet.coneAxis = glm::vec3(0.0f, 0.0f, 1.0f);
+	meshlet.coneCutoff = 1.0f;
+
+	const float sumLength = glm::length(normalSum);
+	if (normals.empty() || sumLength <= 0.0f)
+		return;
+
+	const glm::vec3 axis = normalSum / sumLength;
+	float minDot = 1.0f;
+	for (const glm::vec3& normal : normals)
+		minDot = (std::min)(minDot, glm::dot(axis, normal));
+
+	// Normals spread over more than a hemisphere leave no direction to cull from
+	if (minDot <= 0.1f)
+		return;
+
+	meshlet.coneAxis = axis;
+	meshlet.coneCutoff = std::sqrt(1.0f - minDot * minDot);
+}
+
+uint32_t Meshlets::Build(const float* positions, uint32_t vertexCount, uint32_t* indices, uint32_t indexCount, std::vector<Meshlet>& meshlets)
+{
+	meshlets.clear();
+
+	const uint32_t triangleCount = indexCount / 3;
+	if (triangleCount == 0)
+		return 0;
+
+	// Triangles using each vertex
+	std::vector<uint32_t> adjacencyOffsets(static_cast<size_t>(vertexCount) + 1, 0);
+	for (uint32_t i = 0; i < triangleCount * 3; ++i)
+	{
+		if (indices[i] < vertexCount)
+			adjacencyOffsets[indices[i] + 1]++;
+	}
+	for (uint32_t v = 0; v < vertexCount; ++v)
+		adjacencyOffsets[v + 1] += adjacencyOffsets[v];
+
+	std::vector<uint32_t> adjacency(adjacencyOffsets.back());
+	std::vector<uint32_t> cursor(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+	for (uint32_t i = 0; i < triangleCount * 3; ++i)
+	{
+		if (indices[i] < vertexCount)
+			adjacency[cursor[indices[i]]++] = i / 3;
+	}
+
+	std::vector<bool> emitted(triangleCount, false);
+	std::vector<uint32_t> vertexMeshlet(vertexCount, UINT32_MAX);
+	std::vector<uint32_t> meshletVertices;
+	std::vector<uint32_t> meshletTriangles;
+	std::vector<uint32_t> reordered;
+	reordered.reserve(static_cast<size_t>(triangleCount) * 3);
+
+	const auto newVertices = [&](uint32_t triangle, uint32_t meshlet)
+		{
+			uint32_t count = 0;
+			for (int k = 0; k < 3; ++k)
+				count += vertexMeshlet[indices[triangle * 3 + k]] != meshlet ? 1 : 0;
+			return count;
+		};
+
+	const auto valid = [&](uint32_t triangle)
+		{
+			return indices[triangle * 3] < vertexCount && indices[triangle * 3 + 1] < vertexCount && indices[triangle * 3 + 2] < vertexCount;
+		};
+
+	uint32_t nextSeed = 0;
+	while (true)
+	{
+		while (nextSeed < triangleCount && (emitted[nextSeed] || !valid(nextSeed)))
+			++nextSeed;
+		if (nextSeed == triangleCount)
+			break;
+
+		const uint32_t meshletIndex = static_cast<uint32_t>(meshlets.size());
+		meshletVertices.clear();
+		meshletTriangles.clear();
+
+		uint32_t triangle = nextSeed;
+		while (triangle != UINT32_MAX)
+		{
+			emitted[triangle] = true;
+			meshletTriangles.push_back(triangle);
+			for (int k = 0; k < 3; ++k)
+			{
+				const uint32_t vertex = indices[triangle * 3 + k];
+				if (vertexMeshlet[vertex] != meshletIndex)
+				{
+					vertexMeshlet[vertex] = meshletIndex;
+					meshletVertices.push_back(vertex);
+				}
+			}
+
+			if (meshletTriangles.size() >= MAX_TRIANGLES)
+				break;
+
+			// Next is the neighbour adding the fewest vertices, the cluster stays compact
+			triangle = UINT32_MAX;
+			uint32_t bestNew = 4;
+			for (uint32_t vertex : meshletVertices)
+			{
+				for (uint32_t a = adjacencyOffsets[vertex]; a < adjacencyOffsets[vertex + 1] && bestNew > 0; ++a)
+				{
+					const uint32_t candidate = adjacency[a];
+					if (emitted[candidate] || !valid(candidate))
+						continue;
+
+					const uint32_t added = newVertices(candidate, meshletIndex);
+					if (added < bestNew && meshletVertices.size() + added <= MAX_VERTICES)
+					{
+						bestNew = added;
+						triangle = candidate;
+					}
+				}
+
+				if (bestNew == 0)
+					break;
+			}
+		}
+
+		Meshlet meshlet;
+		meshlet.firstIndex = static_cast<uint32_t>(reordered.size());
+		meshlet.indexCount = static_cast<uint32_t>(meshletTriangles.size() * 3);
+		for (uint32_t t : meshletTriangles)
+			reordered.insert(reordered.end(), indices + t * 3, indices + t * 3 + 3);
+		meshlets.push_back(meshlet);
+	}
+
+	std::copy(reordered.begin(), reordered.end(), indices);
+
+	for (Meshlet& meshlet : meshlets)
+		ComputeBounds(positions, indices, meshlet);
+
+	return static_cast<uint32_t>(reordered.size());
+}
+
+uint32_t Meshlets::Cull(const MeshletBounds& bounds, const glm::vec4 planes[6], const glm::vec3& cameraPosition, bool cullBackfaces, std::vector<uint8_t>& visible)
+{
+	visible.assign(bounds.count, 0);
+
+	const __m128 cameraX = _mm_set1_ps(cameraPosition.x);
+	const __m128 cameraY = _mm_set1_ps(cameraPosition.y);
+	const __m128 cameraZ = _mm_set1_ps(cameraPosition.z);
+	const __m128 zero = _mm_setzero_ps();
+
+	uint32_t visibleCount = 0;
+	for (size_t i = 0; i < bounds.count; i += 4)
+	{
+		const __m128 x = _mm_loadu_ps(&bounds.centerX[i]);
+		const __m128 y = _mm_loadu_ps(&bounds.centerY[i]);
+		const __m128 z = _mm_loadu_ps(&bounds.centerZ[i]);
+		const __m128 r = _mm_loadu_ps(&bounds.radius[i]);
+		const __m128 negativeR = _mm_sub_ps(zero, r);
+
+		// Inside unless fully behind one of the planes
+		__m128 inside = _mm_cmpeq_ps(zero, zero);
+		for (int p = 0; p < 6; ++p)
+		{
+			__m128 distance = _mm_mul_ps(x, _mm_set1_ps(planes[p].x));
+			distance = _mm_add_ps(distance, _mm_mul_ps(y, _mm_set1_ps(planes[p].y)));
+			distance = _mm_add_ps(distance, _mm_mul_ps(z, _mm_set1_ps(planes[p].z)));
+			distance = _mm_add_ps(distance, _mm_set1_ps(planes[p].w));
+			inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, negativeR));
+		}
+
+		if (cullBackfaces)
+		{
+			// dot(center - camera, axis) >= cutoff * |center - camera| + radius
+			const __m128 dx = _mm_sub_ps(x, cameraX);
+			const __m128 dy = _mm_sub_ps(y, cameraY);
+			const __m128 dz = _mm_sub_ps(z, cameraZ);
+			const __m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz)));
+
+			__m128 facing = _mm_mul_ps(dx, _mm_loadu_ps(&bounds.axisX[i]));
+			facing = _mm_add_ps(facing, _mm_mul_ps(dy, _mm_loadu_ps(&bounds.axisY[i])));
+			facing = _mm_add_ps(facing, _mm_mul_ps(dz, _mm_loadu_ps(&bounds.axisZ[i])));
+
+			const __m128 limit = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&bounds.cutoff[i]), length), r);
+			inside = _mm_andnot_ps(_mm_cmpge_ps(facing, limit), inside);
+		}
+
+		const int mask = _mm_movemask_ps(inside);
+		const size_t lanes = (std::min)(static_cast<size_t>(4), bounds.count - i);
+		for (size_t lane = 0; lane < lanes; ++lane)
+		{
+			if (mask & (1 << lane))
+			{
+				visible[i + lane] = 1;
+				visibleCount++;
+			}
+		}
+	}
+
+	return visibleCount;
+}
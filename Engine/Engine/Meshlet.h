@@ -0,0 +1,51 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+// A small cluster of the full mesh triangles, contiguous in its index buffer
+struct Meshlet
+{
+	uint32_t firstIndex = 0;
+	uint32_t indexCount = 0;
+
+	// Bounding sphere
+	glm::vec3 center = glm::vec3(0.0f);
+	float radius = 0.0f;
+
+	// Every triangle faces away from cameras inside the cone around -coneAxis. A cutoff
+	// of 1 disables the test, used for clusters that bend too much.
+	glm::vec3 coneAxis = glm::vec3(0.0f, 0.0f, 1.0f);
+	float coneCutoff = 1.0f;
+};
+
+static_assert(sizeof(Meshlet) == 40, "Meshlets are written to .mesh files as they are laid out");
+
+// The meshlet spheres and cones as separate arrays padded to a multiple of four, so they
+// are tested four at a time
+struct MeshletBounds
+{
+	std::vector<float> centerX, centerY, centerZ, radius;
+	std::vector<float> axisX, axisY, axisZ, cutoff;
+	size_t count = 0;
+
+	void Build(const std::vector<Meshlet>& meshlets);
+	void Clear();
+};
+
+namespace Meshlets
+{
+	static const uint32_t MAX_VERTICES = 64;
+	static const uint32_t MAX_TRIANGLES = 124;
+
+	// Reorders the triangles of indices so each meshlet is a contiguous range, grown
+	// greedily through neighbouring triangles. Triangles indexing missing vertices are
+	// dropped, returns the index count left.
+	uint32_t Build(const float* positions, uint32_t vertexCount, uint32_t* indices, uint32_t indexCount, std::vector<Meshlet>& meshlets);
+
+	// planes and cameraPosition are in the mesh local space, planes normalized with their
+	// normals pointing inside. Writes 1 to visible for every meshlet that survives and
+	// returns how many did.
+	uint32_t Cull(const MeshletBounds& bounds, const glm::vec4 planes[6], const glm::vec3& cameraPosition, bool cullBackfaces, std::vector<uint8_t>& visible);
+}
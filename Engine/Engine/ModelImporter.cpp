@@ -2,10 +2,22 @@
 #include "App.h"
 #include "ComponentMesh.h"
 
+#include <algorithm>
 #include <iostream>
 #include <fstream>
+#include <mutex>
 
 #include "Model.h"
+#include "MeshSimplifier.h"
+
+// Simplified levels generated per mesh, each one targets half the triangles of the last
+#define MAX_LODS 3
+#define LOD_MIN_TRIANGLES 64
+#define LOD_MAX_ERROR 0.05f
+
+// Assimp's DefaultLogger is global and not thread-safe, so while our log stream is attached
+// only one import parses or releases at a time. Building the custom file stays parallel.
+static std::mutex assimpMutex;
 
 ModelImporter::ModelImporter()
 {
@@ -21,9 +33,18 @@ ModelImporter::~ModelImporter()
 
 bool ModelImporter::SaveModel(Resource* resource)
 {
-	const char* path = resource->GetAssetFileDir().c_str();
+	return SaveModel(resource->GetAssetFileDir());
+}
 
-	const aiScene* scene = aiImportFile(path, aiProcessPreset_TargetRealtime_MaxQuality);
+bool ModelImporter::SaveModel(const std::string& assetPath)
+{
+	const char* path = assetPath.c_str();
+
+	const aiScene* scene = nullptr;
+	{
+		std::lock_guard<std::mutex> lock(assimpMutex);
+		scene = aiImportFile(path, aiProcessPreset_TargetRealtime_MaxQuality);
+	}
 	if (scene == nullptr)
 	{
 		LOG(LogType::LOG_ERROR, "Error loading scene %s", path);
@@ -35,7 +56,10 @@ bool ModelImporter::SaveModel(Resource* resource)
 	fileName = fileName.substr(0, fileName.find_last_of("."));
 
 	SaveModelToCustomFile(scene, fileName);
-	aiReleaseImport(scene);
+	{
+		std::lock_guard<std::mutex> lock(assimpMutex);
+		aiReleaseImport(scene);
+	}
 
 	LOG(LogType::LOG_INFO, "%s model Saved", fileName.c_str());
 	return true;
@@ -78,7 +102,7 @@ void ModelImporter::SaveMeshToCustomFile(aiMesh* newMesh, const aiScene* scene,
 	bool hasTextureCoords = newMesh->HasTextureCoords(0);
 
 	// Get counts
-	const uint32_t ranges[4] =
+	uint32_t ranges[4] =
 	{
 		newMesh->mNumFaces * 3,
 		newMesh->mNumVertices,
@@ -105,11 +129,20 @@ void ModelImporter::SaveMeshToCustomFile(aiMesh* newMesh, const aiScene* scene,
 		if (newMesh->mFaces[i].mNumIndices != 3)
 		{
 			LOG(LogType::LOG_WARNING, "Face does not have 3 indices");
+			memset(&indices[i * 3], 0xFF, 3 * sizeof(uint32_t));
 			continue;
 		}
 		memcpy(&indices[i * 3], newMesh->mFaces[i].mIndices, 3 * sizeof(uint32_t));
 	}
 
+	// Meshlets reorder the triangles, skipped faces are dropped on the way
+	std::vector<Meshlet> meshlets;
+	ranges[0] = Meshlets::Build(&newMesh->mVertices[0].x, newMesh->mNumVertices, indices.get(), ranges[0], meshlets);
+
+	std::vector<uint32_t> lodIndices;
+	std::vector<MeshLod> lods;
+	GenerateLods(newMesh, indices.get(), ranges[0], texCoords.get(), lodIndices, lods);
+
 	// Material properties
 	glm::vec4 diffuseColor(1.0f);
 	glm::vec4 specularColor(1.0f);
@@ -167,7 +200,12 @@ void ModelImporter::SaveMeshToCustomFile(aiMesh* newMesh, const aiScene* scene,
 		+ (hasTextureCoords ? (sizeof(float) * ranges[3] * 2) : 0)
 		+ (sizeof(glm::vec4) * 3)
 		+ sizeof(uint32_t)
-		+ diffuseTexturePath.size() + 1;
+		+ diffuseTexturePath.size() + 1
+		+ sizeof(uint32_t)
+		+ (sizeof(uint32_t) * 2 + sizeof(float)) * lods.size()
+		+ sizeof(uint32_t) * lodIndices.size()
+		+ sizeof(uint32_t)
+		+ sizeof(Meshlet) * meshlets.size();
 
 	// Allocate buffer and write data
 	std::unique_ptr<char[]> fileBuffer(new char[size]);
@@ -196,6 +234,22 @@ void ModelImporter::SaveMeshToCustomFile(aiMesh* newMesh, const aiScene* scene,
 	writeData(&texturePathLength, sizeof(uint32_t));
 	writeData(diffuseTexturePath.c_str(), static_cast<size_t>(texturePathLength) + 1);
 
+	// LODs
+	const uint32_t lodCount = static_cast<uint32_t>(lods.size());
+	writeData(&lodCount, sizeof(uint32_t));
+	for (const MeshLod& lod : lods)
+	{
+		writeData(&lod.firstIndex, sizeof(uint32_t));
+		writeData(&lod.indexCount, sizeof(uint32_t));
+		writeData(&lod.error, sizeof(float));
+	}
+	writeData(lodIndices.data(), sizeof(uint32_t) * lodIndices.size());
+
+	// Meshlets
+	const uint32_t meshletCount = static_cast<uint32_t>(meshlets.size());
+	writeData(&meshletCount, sizeof(uint32_t));
+	writeData(meshlets.data(), sizeof(Meshlet) * meshlets.size());
+
 	// Write to file
 	std::ofstream file(filePath, std::ios::binary);
 	if (file.is_open())
@@ -210,6 +264,37 @@ void ModelImporter::SaveMeshToCustomFile(aiMesh* newMesh, const aiScene* scene,
 	}
 }
 
+void ModelImporter::GenerateLods(const aiMesh* mesh, const uint32_t* indices, uint32_t indexCount, const float* texCoords, std::vector<uint32_t>& lodIndices, std::vector<MeshLod>& lods) const
+{
+	std::vector<uint32_t> simplified;
+	uint32_t previousCount = indexCount;
+
+	for (int level = 1; level <= MAX_LODS; ++level)
+	{
+		const uint32_t target = (indexCount >> level) / 3 * 3;
+		if (target < LOD_MIN_TRIANGLES * 3)
+			break;
+
+		const float error = MeshSimplifier::Simplify(&mesh->mVertices[0].x, texCoords, mesh->mNumVertices, indices, indexCount, target, LOD_MAX_ERROR, simplified);
+
+		// Stop once the error bound or locked borders keep the mesh from shrinking
+		if (simplified.size() > previousCount * 3 / 4)
+			break;
+
+		MeshLod lod;
+		lod.firstIndex = static_cast<uint32_t>(lodIndices.size());
+		lod.indexCount = static_cast<uint32_t>(simplified.size());
+		lod.error = error;
+		lods.push_back(lod);
+
+		lodIndices.insert(lodIndices.end(), simplified.begin(), simplified.end());
+		previousCount = lod.indexCount;
+	}
+
+	if (!lods.empty())
+		LOG(LogType::LOG_INFO, "Generated %d LODs, coarsest has %d of %d triangles", static_cast<int>(lods.size()), lods.back().indexCount / 3, indexCount / 3);
+}
+
 void ModelImporter::LoadMeshFromCustomFile(const std::string& filePath, Mesh* mesh)
 {
 	std::ifstream file(filePath, std::ios::binary);
@@ -252,8 +337,48 @@ void ModelImporter::LoadMeshFromCustomFile(const std::string& filePath, Mesh* me
 	file.read(reinterpret_cast<char*>(&texturePathLength), sizeof(uint32_t));
 	mesh->diffuseTexturePath.resize(texturePathLength);
 	file.read(&mesh->diffuseTexturePath[0], texturePathLength);
+	file.ignore(1);
+
+	// LODs, missing from files saved before they were generated
+	uint32_t lodCount = 0;
+	if (file.read(reinterpret_cast<char*>(&lodCount), sizeof(uint32_t)))
+	{
+		uint32_t lodIndexCount = 0;
+		mesh->lods.resize(lodCount);
+		for (MeshLod& lod : mesh->lods)
+		{
+			file.read(reinterpret_cast<char*>(&lod.firstIndex), sizeof(uint32_t));
+			file.read(reinterpret_cast<char*>(&lod.indexCount), sizeof(uint32_t));
+			file.read(reinterpret_cast<char*>(&lod.error), sizeof(float));
+			lodIndexCount = (std::max)(lodIndexCount, lod.firstIndex + lod.indexCount);
+		}
+
+		mesh->lodIndices.resize(lodIndexCount);
+		file.read(reinterpret_cast<char*>(mesh->lodIndices.data()), sizeof(uint32_t) * lodIndexCount);
+
+		if (!file)
+		{
+			LOG(LogType::LOG_WARNING, "Discarding truncated LODs of %s", filePath.c_str());
+			mesh->lods.clear();
+			mesh->lodIndices.clear();
+		}
+	}
 
-	mesh->InitMesh();
+	// Meshlets, missing from files saved before they were built
+	uint32_t meshletCount = 0;
+	if (file && file.read(reinterpret_cast<char*>(&meshletCount), sizeof(uint32_t)))
+	{
+		mesh->meshlets.resize(meshletCount);
+		file.read(reinterpret_cast<char*>(mesh->meshlets.data()), sizeof(Meshlet) * meshletCount);
+
+		if (!file)
+		{
+			LOG(LogType::LOG_WARNING, "Discarding truncated meshlets of %s", filePath.c_str());
+			mesh->meshlets.clear();
+		}
+	}
+
+	mesh->InitMesh(!app->IsHeadless());
 
 	file.close();
 }
@@ -432,7 +557,22 @@ void ModelImporter::LoadModelFromCustomFile(const std::string& filePath, GameObj
 
 	// Load root node
 	if (loadNode)
+	{
+		const size_t objectsBefore = app->scene->sceneRegistry.GetObjectCount();
+		const size_t meshesBefore = ComponentPool<ComponentMesh>::Get().GetLiveCount();
+		const size_t materialsBefore = ComponentPool<ComponentMaterial>::Get().GetLiveCount();
+
 		LoadNodeFromBuffer(buffer.data(), currentPos, orderedMeshes, root, fileName.c_str());
+
+		const size_t objects = app->scene->sceneRegistry.GetObjectCount() - objectsBefore;
+		const size_t meshes = ComponentPool<ComponentMesh>::Get().GetLiveCount() - meshesBefore;
+		const size_t materials = ComponentPool<ComponentMaterial>::Get().GetLiveCount() - materialsBefore;
+		const size_t componentBytes = meshes * sizeof(ComponentMesh) + materials * sizeof(ComponentMaterial);
+
+		LOG(LogType::LOG_INFO, "%s: %d GameObjects, %d meshes, %d materials (%d KB in mesh/material components, %d empty nodes)",
+			fileName.c_str(), static_cast<int>(objects), static_cast<int>(meshes), static_cast<int>(materials),
+			static_cast<int>(componentBytes / 1024), static_cast<int>(objects - meshes));
+	}
 }
 
 void ModelImporter::LoadNodeFromBuffer(const char* buffer, size_t& currentPos, std::vector<Mesh*>& meshes, GameObject* parent, const char* fileName)
@@ -491,7 +631,7 @@ void ModelImporter::LoadNodeFromBuffer(const char* buffer, size_t& currentPos, s
 
 			if (meshIndex < meshes.size())
 			{
-				ComponentMesh* componentMesh = dynamic_cast<ComponentMesh*>(gameObjectNode->AddComponent(gameObjectNode->mesh));
+				ComponentMesh* componentMesh = gameObjectNode->GetOrCreateMesh();
 				componentMesh->mesh = meshes[meshIndex];
 
 				app->resources->ModifyResourceUsageCount(componentMesh->mesh, 1);
@@ -510,14 +650,12 @@ void ModelImporter::LoadNodeFromBuffer(const char* buffer, size_t& currentPos, s
 						newTexture = app->importer->textureImporter->LoadTextureImage(newResource);
 					}
 					if (newTexture != nullptr)
-						gameObjectNode->material->AddTexture(newTexture);
+						gameObjectNode->GetOrCreateMaterial()->SetTexture(newTexture);
 				}
 			}
 
-			parent->children.push_back(gameObjectNode);
+			gameObjectNode->SetParent(parent);
 		}
-
-		app->scene->octreeNeedsUpdate = true;
 	}
 
 	uint32_t numChildren;
@@ -532,8 +670,7 @@ void ModelImporter::LoadNodeFromBuffer(const char* buffer, size_t& currentPos, s
 		{
 			holder->transform->SetTransformMatrix(position, rotation, scale, holder->parent->transform);
 			holder->transform->UpdateTransform();
-			parent->children.push_back(holder);
-			app->scene->octreeNeedsUpdate = true;
+			holder->SetParent(parent);
 		}
 
 		for (uint32_t i = 0; i < numChildren; i++)
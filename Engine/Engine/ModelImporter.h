@@ -19,6 +19,7 @@ public:
 	~ModelImporter();
 
 	bool SaveModel(Resource* resource);
+	bool SaveModel(const std::string& assetPath);
 	bool LoadModel(Resource* resource, GameObject* root);
 
 	void LoadMeshFromCustomFile(const std::string& filePath, Mesh* mesh);
@@ -29,6 +30,7 @@ private:
 	void SaveMeshToCustomFile(aiMesh* mesh, const aiScene* scene, const std::string& filePath);
 	void SaveModelToCustomFile(const aiScene* scene, const std::string& outputPath);
 	void SaveNodeToBuffer(const aiNode* node, std::vector<char>& buffer, size_t& currentPos);
+	void GenerateLods(const aiMesh* mesh, const uint32_t* indices, uint32_t indexCount, const float* texCoords, std::vector<uint32_t>& lodIndices, std::vector<MeshLod>& lods) const;
 	size_t CalculateNodeSize(const aiNode* node);
 
 	// Loading functions
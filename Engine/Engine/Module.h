@@ -1,12 +1,14 @@
 #pragma once
 
+#include <vector>
+
 class App;
 
 class Module
 {
 public:
 	Module() {}
-	Module(App* parent) : active(false), app(parent)
+	Module(App* parent, const char* name) : active(false), app(parent), name(name)
 	{}
 
 	virtual ~Module() {}
@@ -16,6 +18,19 @@ public:
 		active = true;
 	}
 
+	// Modules that have to be awake and started before this one
+	virtual std::vector<Module*> GetDependencies() const
+	{
+		return {};
+	}
+
+	// Runs on a worker while the main thread awakes the other modules, before this
+	// module's Awake. Only for work on the module's own data: no GL, SDL or other modules
+	virtual bool AwakeAsync()
+	{
+		return true;
+	}
+
 	virtual bool Awake()
 	{
 		return true;
@@ -66,4 +81,5 @@ public:
 
 	bool active = true;
 	App* app = nullptr;
+	const char* name = "Module";
 };
\ No newline at end of file
@@ -1,13 +1,18 @@
 #include "ModuleCamera.h"
 #include "App.h"
 
-ModuleCamera::ModuleCamera(App* app) : Module(app)
+ModuleCamera::ModuleCamera(App* app) : Module(app, "Camera")
 {
 }
 
 ModuleCamera::~ModuleCamera()
 {}
 
+std::vector<Module*> ModuleCamera::GetDependencies() const
+{
+	return { app->scene };
+}
+
 bool ModuleCamera::Start()
 {
 	LOG(LogType::LOG_INFO, "Setting up the camera");
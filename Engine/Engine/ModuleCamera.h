@@ -11,6 +11,7 @@ public:
 	ModuleCamera(App* app);
 	~ModuleCamera();
 
+	std::vector<Module*> GetDependencies() const override;
 	bool Start();
 	bool Update(float dt);
 	void HandleInput();
@@ -0,0 +1,62 @@
+#include "ModuleDebugDraw.h"
+#include "App.h"
+
+ModuleDebugDraw::ModuleDebugDraw(App* app) : Module(app, "DebugDraw")
+{
+}
+
+ModuleDebugDraw::~ModuleDebugDraw()
+{
+}
+
+bool ModuleDebugDraw::CleanUp()
+{
+	std::lock_guard<std::mutex> lock(frameMutex);
+	frame = DebugDrawList();
+
+	return true;
+}
+
+void ModuleDebugDraw::AddLine(const glm::vec3& from, const glm::vec3& to, const glm::vec4& color, float width)
+{
+	std::lock_guard<std::mutex> lock(frameMutex);
+	frame.AddLine(from, to, color, width);
+}
+
+void ModuleDebugDraw::AddBox(const glm::vec3* corners, const glm::vec4& color, float width)
+{
+	std::lock_guard<std::mutex> lock(frameMutex);
+	frame.AddBox(corners, color, width);
+}
+
+void ModuleDebugDraw::AddAABB(const glm::vec3& min, const glm::vec3& max, const glm::vec4& color, float width)
+{
+	std::lock_guard<std::mutex> lock(frameMutex);
+	frame.AddAABB(min, max, color, width);
+}
+
+void ModuleDebugDraw::AddPoint(const glm::vec3& position, const glm::vec4& color)
+{
+	std::lock_guard<std::mutex> lock(frameMutex);
+	frame.AddPoint(position, color);
+}
+
+void ModuleDebugDraw::AddList(const DebugDrawList& list)
+{
+	std::lock_guard<std::mutex> lock(frameMutex);
+	frame.Append(list);
+}
+
+void ModuleDebugDraw::TakeFrame(DebugDrawList& list)
+{
+	std::lock_guard<std::mutex> lock(frameMutex);
+
+	// The emptied list comes back with its storage for the next frame
+	std::swap(list, frame);
+}
+
+void ModuleDebugDraw::DiscardFrame()
+{
+	std::lock_guard<std::mutex> lock(frameMutex);
+	frame.Clear();
+}
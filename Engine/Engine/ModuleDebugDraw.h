@@ -0,0 +1,35 @@
+#pragma once
+
+#include "Module.h"
+#include "DebugDraw.h"
+
+#include <glm/glm.hpp>
+#include <mutex>
+
+// Debug shapes any thread can add while a frame runs, the renderer adds the grid and the
+// octree here too. Every frame the renderer takes them, headless and idle frames included,
+// and draws them in the scene view, so each shape is shown for one frame. Per-item shapes
+// (normals, bounding boxes) stay in each view's own list, see RenderView::Record.
+class ModuleDebugDraw : public Module
+{
+public:
+	ModuleDebugDraw(App* app);
+	~ModuleDebugDraw();
+
+	bool CleanUp();
+
+	void AddLine(const glm::vec3& from, const glm::vec3& to, const glm::vec4& color = glm::vec4(1.0f), float width = 1.0f);
+	void AddBox(const glm::vec3* corners, const glm::vec4& color = glm::vec4(1.0f), float width = 1.0f);
+	void AddAABB(const glm::vec3& min, const glm::vec3& max, const glm::vec4& color = glm::vec4(1.0f), float width = 1.0f);
+	void AddPoint(const glm::vec3& position, const glm::vec4& color = glm::vec4(1.0f));
+	void AddList(const DebugDrawList& list);
+
+	// Moves the shapes of this frame into list, which must be empty
+	void TakeFrame(DebugDrawList& list);
+	// For frames that draw nothing
+	void DiscardFrame();
+
+private:
+	std::mutex frameMutex;
+	DebugDrawList frame;
+};
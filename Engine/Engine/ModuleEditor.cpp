@@ -3,7 +3,7 @@
 
 #include "imgui_internal.h"
 
-ModuleEditor::ModuleEditor(App* app) : Module(app)
+ModuleEditor::ModuleEditor(App* app) : Module(app, "Editor")
 {}
 
 ModuleEditor::~ModuleEditor()
@@ -15,6 +15,11 @@ ModuleEditor::~ModuleEditor()
 	editorWindows.clear();
 }
 
+std::vector<Module*> ModuleEditor::GetDependencies() const
+{
+	return { app->window, app->scene, app->importer };
+}
+
 bool ModuleEditor::Awake()
 {
 	LOG(LogType::LOG_INFO, "ModuleEditor");
@@ -59,9 +64,21 @@ bool ModuleEditor::Awake()
 	resourcesWindow = new ResourcesWindow(WindowType::RESOURCES, "Resources");
 	editorWindows.push_back(resourcesWindow);
 
+	app->scene->sceneEvents.Subscribe(this);
+	app->scene->sceneEvents.Subscribe(resourcesWindow);
+
 	return ret;
 }
 
+void ModuleEditor::OnSceneEvents(const std::vector<SceneEvent>& events)
+{
+	for (const SceneEvent& event : events)
+	{
+		if (event.type == SceneEventType::OBJECT_DESTROYED && event.gameObject == selectedGameObject)
+			selectedGameObject = nullptr;
+	}
+}
+
 bool ModuleEditor::CleanUp()
 {
 	LOG(LogType::LOG_INFO, "Cleaning ModuleEditor");
@@ -82,6 +99,9 @@ void ModuleEditor::DrawEditor()
 	// Bar
 	MainMenuBar();
 
+	// The status bar takes its space from the viewport before the dockspace is laid out
+	StatusBar();
+
 	// Docking
 	Docking();
 
@@ -92,19 +112,6 @@ void ModuleEditor::DrawEditor()
 			editorWindow->DrawWindow();
 	}
 
-	/*// Draw status bar
-	ImGuiViewport* viewport = ImGui::GetMainViewport();
-	ImGuiWindowFlags windowFlags = ImGuiWindowFlags_NoScrollbar | ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_MenuBar;
-
-	if (ImGui::BeginViewportSideBar("##MainStatusBar", viewport, ImGuiDir_Down, ImGui::GetFrameHeight(), windowFlags))
-	{
-		if (ImGui::BeginMenuBar())
-		{
-			ImGui::EndMenuBar();
-		}
-		ImGui::End();
-	}*/
-
 	if (app->importer->isDraggingFile)
 		app->importer->TryImportFile();
 
@@ -122,7 +129,7 @@ void ModuleEditor::Docking()
 		ImGuiWindowFlags_NoNavFocus | ImGuiWindowFlags_NoBringToFrontOnFocus;
 
 	ImGui::SetNextWindowPos(viewport->Pos);
-	ImGui::SetNextWindowSize(viewport->Size);
+	ImGui::SetNextWindowSize(ImVec2(viewport->Size.x, viewport->WorkPos.y + viewport->WorkSize.y - viewport->Pos.y));
 	ImGui::SetNextWindowViewport(viewport->ID);
 	ImGui::SetNextWindowBgAlpha(0.0f);
 
@@ -138,6 +145,37 @@ void ModuleEditor::Docking()
 	ImGui::End();
 }
 
+void ModuleEditor::StatusBar()
+{
+	ImGuiViewport* viewport = ImGui::GetMainViewport();
+	ImGuiWindowFlags windowFlags = ImGuiWindowFlags_NoScrollbar | ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_MenuBar;
+
+	if (ImGui::BeginViewportSideBar("##MainStatusBar", viewport, ImGuiDir_Down, ImGui::GetFrameHeight(), windowFlags))
+	{
+		if (ImGui::BeginMenuBar())
+		{
+			const auto& tasks = app->tasks.GetTasks();
+			if (tasks.empty())
+			{
+				ImGui::TextDisabled("Ready");
+			}
+			else
+			{
+				const BackgroundTask* task = tasks.front().get();
+				ImGui::Text("%s", task->GetName().c_str());
+				ImGui::ProgressBar(task->GetProgress(), ImVec2(200.0f, 0.0f));
+
+				if (tasks.size() > 1)
+					ImGui::TextDisabled("+%d more", static_cast<int>(tasks.size() - 1));
+
+				ImGui::TextDisabled("%.2f / %.2f ms", app->tasks.GetLastFrameMs(), app->tasks.frameBudgetMs);
+			}
+			ImGui::EndMenuBar();
+		}
+	}
+	ImGui::End();
+}
+
 void ModuleEditor::MainMenuBar()
 {
 	ImGui::BeginMainMenuBar();
@@ -22,21 +22,26 @@
 #include <list>
 
 #include "ResourcesWindow.h"
+#include "SceneEvents.h"
 
-class ModuleEditor : public Module
+class ModuleEditor : public Module, public SceneEventListener
 {
 public:
 	ModuleEditor(App* app);
 	~ModuleEditor();
 
+	std::vector<Module*> GetDependencies() const override;
 	bool Awake();
 	bool CleanUp();
 
 	void DrawEditor();
 	void Docking();
+	void StatusBar();
 	void MainMenuBar();
 	void ApplyStyle();
 
+	void OnSceneEvents(const std::vector<SceneEvent>& events) override;
+
 public:
 	GameObject* selectedGameObject = nullptr;
 
@@ -3,7 +3,7 @@
 
 #include <fstream>
 
-ModuleFileSystem::ModuleFileSystem(App* app) : Module(app)
+ModuleFileSystem::ModuleFileSystem(App* app) : Module(app, "FileSystem")
 {
 	std::filesystem::create_directories("Library");
 	std::filesystem::create_directories("Library/Textures");
@@ -93,7 +93,8 @@ std::string ModuleFileSystem::CopyFileIfNotExists(const std::string& source)
 		std::ifstream src(source, std::ios::binary);
 		std::ofstream dst(destination, std::ios::binary);
 		dst << src.rdbuf();
-		app->editor->projectWindow->UpdateDirectoryContent();
+		if (app->editor->projectWindow)
+			app->editor->projectWindow->UpdateDirectoryContent();
 		return destination;
 	}
 	return source;
@@ -123,4 +124,15 @@ std::string ModuleFileSystem::GetFileNameWithoutExtension(const std::string& fil
 bool ModuleFileSystem::FileExists(const std::string& filePath)
 {
 	return std::filesystem::exists(filePath);
+}
+
+bool ModuleFileSystem::IsUpToDate(const std::string& derivedPath, const std::string& sourcePath)
+{
+	std::error_code error;
+	const auto derivedTime = std::filesystem::last_write_time(derivedPath, error);
+	if (error)
+		return false;
+
+	const auto sourceTime = std::filesystem::last_write_time(sourcePath, error);
+	return error || derivedTime >= sourceTime;
 }
\ No newline at end of file
@@ -22,4 +22,6 @@ public:
 	std::string GetFileNameWithoutExtension(const std::string& filePath);
 
 	bool FileExists(const std::string& filePath);
+	// False when the derived file is missing or older than its source
+	bool IsUpToDate(const std::string& derivedPath, const std::string& sourcePath);
 };
\ No newline at end of file
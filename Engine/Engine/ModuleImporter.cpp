@@ -7,7 +7,68 @@
 #include <filesystem>
 #include <fstream>
 
-ModuleImporter::ModuleImporter(App* app) : Module(app)
+// Writes the library files of a new asset off the main thread. The resource is created
+// before and only loaded into the scene once the files are complete.
+class ImportTask : public BackgroundTask
+{
+public:
+	ImportTask(Resource* resource, ResourceType type, const std::string& name)
+		: BackgroundTask("Importing " + name, TaskMode::WORKER), resource(resource), type(type) {}
+
+	bool Step(int64_t deadlineNs) override
+	{
+		app->importer->SaveToLibrary(resource, type);
+		SetProgress(1.0f);
+		return true;
+	}
+
+	void Complete() override
+	{
+		app->importer->pendingImports.erase(resource->GetAssetFileDir());
+
+		for (int i = 0; i < sceneInstances; ++i)
+			app->importer->LoadToScene(resource, type);
+	}
+
+public:
+	Resource* resource = nullptr;
+	ResourceType type;
+	int sceneInstances = 0;
+};
+
+struct IconFile
+{
+	GLuint Icons::* icon;
+	const char* path;
+};
+
+static const IconFile ICON_FILES[] =
+{
+	// Project
+	{ &Icons::folderIcon, "Engine/Icons/folder.png" },
+	{ &Icons::openFolderIcon, "Engine/Icons/open_folder.png" },
+	{ &Icons::fileIcon, "Engine/Icons/file.png" },
+	{ &Icons::pngFileIcon, "Engine/Icons/file_png.png" },
+	{ &Icons::ddsFileIcon, "Engine/Icons/file_dds.png" },
+	{ &Icons::tgaFileIcon, "Engine/Icons/file_tga.png" },
+	{ &Icons::fbxFileIcon, "Engine/Icons/file_fbx.png" },
+	{ &Icons::sceneFileIcon, "Engine/Icons/file_scene.png" },
+	{ &Icons::dotsIcon, "Engine/Icons/dots.png" },
+
+	// Console
+	{ &Icons::infoIcon, "Engine/Icons/info.png" },
+	{ &Icons::warningIcon, "Engine/Icons/warning.png" },
+	{ &Icons::errorIcon, "Engine/Icons/error.png" },
+
+	// Game
+	{ &Icons::playIcon, "Engine/Icons/play.png" },
+	{ &Icons::pauseIcon, "Engine/Icons/pause.png" },
+	{ &Icons::stepIcon, "Engine/Icons/step.png" }
+};
+
+static const size_t ICON_FILE_COUNT = sizeof(ICON_FILES) / sizeof(ICON_FILES[0]);
+
+ModuleImporter::ModuleImporter(App* app) : Module(app, "Importer")
 {
 	textureImporter = new TextureImporter();
 	modelImporter = new ModelImporter();
@@ -17,49 +78,48 @@ ModuleImporter::~ModuleImporter()
 {
 }
 
+std::vector<Module*> ModuleImporter::GetDependencies() const
+{
+	return { app->window, app->fileSystem, app->resources };
+}
+
+bool ModuleImporter::AwakeAsync()
+{
+	// Nothing draws the editor in headless runs
+	if (app->IsHeadless())
+		return true;
+
+	decodedIcons.resize(ICON_FILE_COUNT);
+	for (size_t i = 0; i < ICON_FILE_COUNT; ++i)
+	{
+		if (!textureImporter->DecodeIconImage(ICON_FILES[i].path, decodedIcons[i]))
+			LOG(LogType::LOG_WARNING, "Could not load icon %s", ICON_FILES[i].path);
+	}
+
+	return true;
+}
+
 bool ModuleImporter::Awake()
 {
-	// Project
-	icons.folderIcon = textureImporter->LoadIconImage("Engine/Icons/folder.png");
-	icons.openFolderIcon = textureImporter->LoadIconImage("Engine/Icons/open_folder.png");
-	icons.fileIcon = textureImporter->LoadIconImage("Engine/Icons/file.png");
-	icons.pngFileIcon = textureImporter->LoadIconImage("Engine/Icons/file_png.png");
-	icons.ddsFileIcon = textureImporter->LoadIconImage("Engine/Icons/file_dds.png");
-	icons.tgaFileIcon = textureImporter->LoadIconImage("Engine/Icons/file_tga.png");
-	icons.fbxFileIcon = textureImporter->LoadIconImage("Engine/Icons/file_fbx.png");
-	icons.sceneFileIcon = textureImporter->LoadIconImage("Engine/Icons/file_scene.png");
-	icons.dotsIcon = textureImporter->LoadIconImage("Engine/Icons/dots.png");
+	if (app->IsHeadless())
+		return true;
 
-	// Console
-	icons.infoIcon = textureImporter->LoadIconImage("Engine/Icons/info.png");
-	icons.warningIcon = textureImporter->LoadIconImage("Engine/Icons/warning.png");
-	icons.errorIcon = textureImporter->LoadIconImage("Engine/Icons/error.png");
+	for (size_t i = 0; i < ICON_FILE_COUNT; ++i)
+		icons.*ICON_FILES[i].icon = textureImporter->UploadIconImage(decodedIcons[i]);
 
-	// Game
-	icons.playIcon = textureImporter->LoadIconImage("Engine/Icons/play.png");
-	icons.pauseIcon = textureImporter->LoadIconImage("Engine/Icons/pause.png");
-	icons.stepIcon = textureImporter->LoadIconImage("Engine/Icons/step.png");
+	decodedIcons.clear();
 
 	return true;
 }
 
 bool ModuleImporter::CleanUp()
 {
-	glDeleteTextures(1, &icons.folderIcon);
-	glDeleteTextures(1, &icons.openFolderIcon);
-	glDeleteTextures(1, &icons.fileIcon);
-	glDeleteTextures(1, &icons.pngFileIcon);
-	glDeleteTextures(1, &icons.tgaFileIcon);
-	glDeleteTextures(1, &icons.ddsFileIcon);
-	glDeleteTextures(1, &icons.fbxFileIcon);
-	glDeleteTextures(1, &icons.sceneFileIcon);
-	glDeleteTextures(1, &icons.dotsIcon);
-	glDeleteTextures(1, &icons.infoIcon);
-	glDeleteTextures(1, &icons.warningIcon);
-	glDeleteTextures(1, &icons.errorIcon);
-	glDeleteTextures(1, &icons.playIcon);
-	glDeleteTextures(1, &icons.pauseIcon);
-	glDeleteTextures(1, &icons.stepIcon);
+	for (size_t i = 0; i < ICON_FILE_COUNT; ++i)
+	{
+		GLuint& icon = icons.*ICON_FILES[i].icon;
+		if (icon != 0)
+			glDeleteTextures(1, &icon);
+	}
 
 	delete modelImporter;
 	modelImporter = nullptr;
@@ -100,13 +160,30 @@ void ModuleImporter::ImportFile(const std::string& fileDir, bool addToScene)
 
 	ResourceType resourceType = app->resources->GetResourceTypeFromExtension(extension);
 
+	// Already being imported, the resource exists but its library files are not written yet
+	auto pending = pendingImports.find(newDir);
+	if (pending != pendingImports.end())
+	{
+		if (addToScene)
+			pending->second->sceneInstances++;
+		return;
+	}
+
 	Resource* newResource = app->resources->FindResourceInLibrary(newDir, resourceType);
 
-	if (!newResource)
-		newResource = ImportFileToLibrary(newDir, resourceType);
+	if (newResource)
+	{
+		if (addToScene)
+			LoadToScene(newResource, resourceType);
+		return;
+	}
+
+	newResource = app->resources->CreateResource(newDir, resourceType);
 
-	if (addToScene)
-		LoadToScene(newResource, resourceType);
+	ImportTask* task = new ImportTask(newResource, resourceType, app->fileSystem->GetFileNameWithoutExtension(newDir));
+	task->sceneInstances = addToScene ? 1 : 0;
+	pendingImports[newDir] = task;
+	app->tasks.Add(task);
 }
 
 void ModuleImporter::LoadToScene(Resource* newResource, ResourceType resourceType)
@@ -124,7 +201,7 @@ void ModuleImporter::LoadToScene(Resource* newResource, ResourceType resourceTyp
 		}
 		if (newTexture && app->editor->selectedGameObject)
 		{
-			app->editor->selectedGameObject->material->AddTexture(newTexture);
+			app->editor->selectedGameObject->ApplyTexture(newTexture);
 		}
 		break;
 	}
@@ -139,7 +216,13 @@ void ModuleImporter::SetDraggedFile(const std::string& filePath)
 Resource* ModuleImporter::ImportFileToLibrary(const std::string& fileDir, ResourceType type)
 {
 	Resource* resource = app->resources->CreateResource(fileDir, type);
+	SaveToLibrary(resource, type);
 
+	return resource;
+}
+
+void ModuleImporter::SaveToLibrary(Resource* resource, ResourceType type)
+{
 	switch (type)
 	{
 	case ResourceType::MODEL:
@@ -149,6 +232,4 @@ Resource* ModuleImporter::ImportFileToLibrary(const std::string& fileDir, Resour
 		textureImporter->SaveTextureFile(resource);
 		break;
 	}
-
-	return resource;
 }
\ No newline at end of file
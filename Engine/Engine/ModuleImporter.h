@@ -8,6 +8,10 @@
 
 #include <GL/glew.h>
 #include <string>
+#include <unordered_map>
+#include <vector>
+
+class ImportTask;
 
 struct Icons
 {
@@ -34,6 +38,8 @@ public:
 	ModuleImporter(App* app);
 	virtual ~ModuleImporter();
 
+	std::vector<Module*> GetDependencies() const override;
+	bool AwakeAsync() override;
 	bool Awake();
 	bool CleanUp();
 
@@ -42,6 +48,7 @@ public:
 	void SetDraggedFile(const std::string& filePath);
 
 	Resource* ImportFileToLibrary(const std::string& fileDir, ResourceType type);
+	void SaveToLibrary(Resource* resource, ResourceType type);
 	void LoadToScene(Resource* newResource, ResourceType resourceType);
 
 public:
@@ -52,5 +59,13 @@ public:
 	ModelImporter* modelImporter;
 
 private:
+	friend class ImportTask;
+
 	std::string draggedFile;
+
+	// Decoded in AwakeAsync, uploaded in Awake
+	std::vector<IconImage> decodedIcons;
+
+	// Assets whose library files are being written on a worker, by asset path
+	std::unordered_map<std::string, ImportTask*> pendingImports;
 };
\ No newline at end of file
@@ -3,7 +3,7 @@
 
 #include <string>
 
-ModuleInput::ModuleInput(App* app) : Module(app), cursor(DEFAULT), mouse_x(0), mouse_y(0), mouse_z(0), mouse_x_motion(0), mouse_y_motion(0)
+ModuleInput::ModuleInput(App* app) : Module(app, "Input"), cursor(DEFAULT), mouse_x(0), mouse_y(0), mouse_z(0), mouse_x_motion(0), mouse_y_motion(0)
 {
 	for (int i = 0; i < MAX_KEYS; ++i) keyboard[i] = KEY_IDLE;
 
@@ -15,6 +15,11 @@ ModuleInput::~ModuleInput()
 {
 }
 
+std::vector<Module*> ModuleInput::GetDependencies() const
+{
+	return { app->window };
+}
+
 bool ModuleInput::Awake()
 {
 	LOG(LogType::LOG_INFO, "Init SDL input event system");
@@ -40,6 +45,9 @@ bool ModuleInput::PreUpdate(float dt)
 
 	const Uint8* keys = SDL_GetKeyboardState(NULL);
 
+	// Held keys and buttons keep the editor awake, repeat events are too sparse for that
+	bool inputActive = false;
+
 	for (int i = 0; i < MAX_KEYS; ++i)
 	{
 		if (keys[i] == 1)
@@ -56,6 +64,8 @@ bool ModuleInput::PreUpdate(float dt)
 			else
 				keyboard[i] = KEY_IDLE;
 		}
+
+		inputActive |= keyboard[i] != KEY_IDLE;
 	}
 
 	Uint32 buttons = SDL_GetMouseState(&mouse_x, &mouse_y);
@@ -80,13 +90,20 @@ bool ModuleInput::PreUpdate(float dt)
 			else
 				mouse_buttons[i] = KEY_IDLE;
 		}
+
+		inputActive |= mouse_buttons[i] != KEY_IDLE;
 	}
 
+	if (inputActive)
+		app->RequestRedraw();
+
 	mouse_x_motion = mouse_y_motion = 0;
 
 	SDL_Event e;
 	while (SDL_PollEvent(&e))
 	{
+		app->RequestRedraw();
+
 		ImGui_ImplSDL2_ProcessEvent(&e);
 
 		switch (e.type)
@@ -36,6 +36,7 @@ public:
 	ModuleInput(App* app);
 	~ModuleInput();
 
+	std::vector<Module*> GetDependencies() const override;
 	bool Awake();
 	bool PreUpdate(float dt);
 	bool CleanUp();
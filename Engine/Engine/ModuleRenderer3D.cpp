@@ -10,8 +10,9 @@
 #include <IL/ilut.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include <fstream>
 
-ModuleRenderer3D::ModuleRenderer3D(App* app) : Module(app), rboScene(0), fboSceneTexture(0), fboScene(0), rboGame(0), fboGameTexture(0), fboGame(0), checkerTextureId(0), checkerImage{}
+ModuleRenderer3D::ModuleRenderer3D(App* app) : Module(app, "Renderer3D"), fboSceneTexture(0), fboGameTexture(0), checkerTextureId(0), checkerImage{}
 {
 }
 
@@ -19,10 +20,25 @@ ModuleRenderer3D::~ModuleRenderer3D()
 {
 }
 
+std::vector<Module*> ModuleRenderer3D::GetDependencies() const
+{
+	return { app->window, app->scene, app->editor };
+}
+
 bool ModuleRenderer3D::Awake()
 {
 	bool ret = true;
 
+	app->scene->sceneEvents.Subscribe(this);
+	app->scene->sceneEvents.Subscribe(&staticBatcher);
+
+	// Headless runs still cull every frame but never touch GL
+	if (app->IsHeadless())
+	{
+		OnResize(SCREEN_WIDTH, SCREEN_HEIGHT);
+		return true;
+	}
+
 	GLenum err = glewInit();
 	if (err != GLEW_OK) {
 		LOG(LogType::LOG_ERROR, "Error in loading Glew: %s\n", glewGetErrorString(err));
@@ -33,54 +49,14 @@ bool ModuleRenderer3D::Awake()
 
 	if (ret == true)
 	{
-		glMatrixMode(GL_PROJECTION);
-		glLoadIdentity();
-
-		GLenum error = glGetError();
-		if (error != GL_NO_ERROR)
-		{
-			LOG(LogType::LOG_ERROR, "Error initializing OpenGL! %s\n", gluErrorString(error));
-			ret = false;
-		}
-
-		glMatrixMode(GL_MODELVIEW);
-		glLoadIdentity();
-
-		error = glGetError();
-		if (error != GL_NO_ERROR)
-		{
-			LOG(LogType::LOG_ERROR, "Error initializing OpenGL! %s\n", gluErrorString(error));
-			ret = false;
-		}
-
-		glHint(GL_PERSPECTIVE_CORRECTION_HINT, GL_NICEST);
-		glClearDepth(1.0f);
-
-		glClearColor(0.1f, 0.1f, 0.1f, 1.f);
-
-		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-		error = glGetError();
-		if (error != GL_NO_ERROR)
-		{
-			LOG(LogType::LOG_ERROR, "Error initializing OpenGL! %s\n", gluErrorString(error));
-			ret = false;
-		}
-
-		GLfloat MaterialAmbient[] = { 1.0f, 1.0f, 1.0f, 1.0f };
-		glMaterialfv(GL_FRONT_AND_BACK, GL_AMBIENT, MaterialAmbient);
-
-		GLfloat MaterialDiffuse[] = { 1.0f, 1.0f, 1.0f, 1.0f };
-		glMaterialfv(GL_FRONT_AND_BACK, GL_DIFFUSE, MaterialDiffuse);
-
-		glEnable(GL_DEPTH_TEST);
-		glEnable(GL_CULL_FACE);
-		glEnable(GL_COLOR_MATERIAL);
-		glEnable(GL_TEXTURE_2D);
-
+		ret = InitRenderState();
 		ilutRenderer(ILUT_OPENGL);
 	}
 
+	// Before the render thread exists, it shares the programs and buffers
+	glBackend.shaders.Init();
+	glBackend.instanceRenderer.Init();
+
 	for (int i = 0; i < CHECKERS_HEIGHT; i++) {
 		for (int j = 0; j < CHECKERS_WIDTH; j++) {
 			int c = ((((i & 0x8) == 0) ^ (((j & 0x8)) == 0))) * 255;
@@ -100,17 +76,71 @@ bool ModuleRenderer3D::Awake()
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
 	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, CHECKERS_WIDTH, CHECKERS_HEIGHT, 0, GL_RGBA, GL_UNSIGNED_BYTE, checkerImage);
 
-	CreateFramebuffer();
-
 	OnResize(SCREEN_WIDTH, SCREEN_HEIGHT);
 
+	if (threadedRendering)
+		StartRenderThread();
+
+	return ret;
+}
+
+bool ModuleRenderer3D::InitRenderState() const
+{
+	bool ret = true;
+
+	glMatrixMode(GL_PROJECTION);
+	glLoadIdentity();
+
+	GLenum error = glGetError();
+	if (error != GL_NO_ERROR)
+	{
+		LOG(LogType::LOG_ERROR, "Error initializing OpenGL! %s\n", gluErrorString(error));
+		ret = false;
+	}
+
+	glMatrixMode(GL_MODELVIEW);
+	glLoadIdentity();
+
+	error = glGetError();
+	if (error != GL_NO_ERROR)
+	{
+		LOG(LogType::LOG_ERROR, "Error initializing OpenGL! %s\n", gluErrorString(error));
+		ret = false;
+	}
+
+	glHint(GL_PERSPECTIVE_CORRECTION_HINT, GL_NICEST);
+	glClearDepth(1.0f);
+
+	glClearColor(0.1f, 0.1f, 0.1f, 1.f);
+
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+	error = glGetError();
+	if (error != GL_NO_ERROR)
+	{
+		LOG(LogType::LOG_ERROR, "Error initializing OpenGL! %s\n", gluErrorString(error));
+		ret = false;
+	}
+
+	GLfloat MaterialAmbient[] = { 1.0f, 1.0f, 1.0f, 1.0f };
+	glMaterialfv(GL_FRONT_AND_BACK, GL_AMBIENT, MaterialAmbient);
+
+	GLfloat MaterialDiffuse[] = { 1.0f, 1.0f, 1.0f, 1.0f };
+	glMaterialfv(GL_FRONT_AND_BACK, GL_DIFFUSE, MaterialDiffuse);
+
+	glEnable(GL_DEPTH_TEST);
+	glEnable(GL_CULL_FACE);
+	glEnable(GL_COLOR_MATERIAL);
+	glEnable(GL_TEXTURE_2D);
+
 	return ret;
 }
 
 bool ModuleRenderer3D::PreUpdate(float dt)
 {
-	if (updateFramebuffer)
+	if (updateFramebuffer && !app->IsHeadless())
 	{
+		app->RequestRedraw();
 		OnResize(static_cast<int>(app->editor->sceneWindow->windowSize.x), static_cast<int>(app->editor->sceneWindow->windowSize.y));
 		updateFramebuffer = false;
 	}
@@ -120,170 +150,467 @@ bool ModuleRenderer3D::PreUpdate(float dt)
 
 bool ModuleRenderer3D::PostUpdate(float dt)
 {
-	// Render first camera
-	glBindFramebuffer(GL_FRAMEBUFFER, fboScene);
-	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+	if (app->IsHeadless())
+	{
+		RenderSnapshot& snapshot = snapshots[writeSnapshot];
+		staticBatcher.Update(renderables);
+		snapshot.Clear();
+		TakeDebugDraw(snapshot);
+		CullViews(snapshot);
+		ExecuteHeadless(snapshot);
+		app->resources->ReleaseRetired();
+		return true;
+	}
 
-	glMatrixMode(GL_PROJECTION);
-	glLoadIdentity();
+	if (app->IsIdle())
+	{
+		// Nothing changed, keep showing the last targets and only refresh the editor
+		if (threadedRendering)
+			WaitForRenderThread();
 
-	glm::mat4 projectionMatrix = app->scene->sceneCamera->GetProjectionMatrix();
-	glLoadMatrixf(glm::value_ptr(projectionMatrix));
+		app->debugDraw->DiscardFrame();
+	}
+	else if (threadedRendering)
+	{
+		RenderSnapshot& snapshot = snapshots[writeSnapshot];
+		BuildSnapshot(snapshot);
 
-	glMatrixMode(GL_MODELVIEW);
-	glLoadIdentity();
+		// Frame N is drawn while the simulation of frame N+1 runs
+		WaitForRenderThread();
+
+		snapshot.uploadFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		glFlush();
+
+		{
+			std::lock_guard<std::mutex> lock(renderMutex);
+			pendingSnapshot = &snapshot;
+			pendingTarget = 1 - displayedTarget;
+		}
+		renderCondition.notify_all();
+
+		writeSnapshot = 1 - writeSnapshot;
+	}
+	else
+	{
+		RenderSnapshot& snapshot = snapshots[writeSnapshot];
+		BuildSnapshot(snapshot);
+		ExecuteSnapshot(snapshot, displayedTarget);
+		renderStats = glBackend.state.stats;
+	}
+
+	// The snapshot submitted last frame has executed and the new one was built without
+	// the resources removed since, so their meshes and geometry ranges can go
+	app->resources->ReleaseRetired();
+
+	fboSceneTexture = sceneTargets[displayedTarget].texture;
+	fboGameTexture = gameTargets[displayedTarget].texture;
+
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-	glm::mat4 viewMatrix = app->scene->sceneCamera->GetViewMatrix();
-	glLoadMatrixf(glm::value_ptr(viewMatrix));
+	app->editor->DrawEditor();
 
-	grid.Render();
+	SDL_GL_SwapWindow(app->window->window);
 
-	DrawQueuedMeshes(app->scene->sceneCamera);
+	return true;
+}
+
+void ModuleRenderer3D::BuildSnapshot(RenderSnapshot& snapshot)
+{
+	staticBatcher.Update(renderables);
+	snapshot.Clear();
+
+	const auto& preferences = app->editor->preferencesWindow;
+	snapshot.drawTextures = preferences->drawTextures;
+	snapshot.wireframe = preferences->wireframe;
+	snapshot.shadedWireframe = preferences->shadedWireframe;
+	snapshot.cullFace = preferences->cullFace;
+	snapshot.shaders = preferences->shaders && glBackend.shaders.IsAvailable() && glBackend.instanceRenderer.IsAvailable();
+	snapshot.multiDraw = snapshot.shaders && preferences->multiDraw && glBackend.instanceRenderer.SupportsMultiDraw();
+	snapshot.instancing = snapshot.shaders && (preferences->instancing || snapshot.multiDraw);
+	snapshot.vertexNormalLength = preferences->vertexNormalLength;
+	snapshot.faceNormalLength = preferences->faceNormalLength;
+	snapshot.vertexNormalColor = preferences->vertexNormalColor;
+	snapshot.faceNormalColor = preferences->faceNormalColor;
+
+	TakeDebugDraw(snapshot);
+
+	// The views are recorded with the settings above
+	CullViews(snapshot);
+}
+
+void ModuleRenderer3D::TakeDebugDraw(RenderSnapshot& snapshot)
+{
+	sceneDebugDraw.Clear();
+	grid.AddLines(sceneDebugDraw);
 
 	if (app->scene->drawOctree)
-		app->scene->sceneOctree->Draw(app->scene->octreeColor);
+	{
+		octreeBounds.clear();
+		app->scene->sceneOctree->CollectBounds(octreeBounds);
+		Octree::AddBounds(sceneDebugDraw, octreeBounds, app->scene->octreeColor);
+	}
 
-	if (app->scene->activeGameCamera)
+	app->debugDraw->AddList(sceneDebugDraw);
+	app->debugDraw->TakeFrame(snapshot.debugDraw);
+}
+
+void ModuleRenderer3D::CullViews(RenderSnapshot& snapshot) const
+{
+	ComponentCamera* gameCamera = app->scene->activeGameCamera;
+	snapshot.gameView.enabled = gameCamera != nullptr;
+
+	// Cameras created after the last resize (new or loaded scenes) start at the window size
+	if (gameCamera != nullptr && (gameCamera->screenWidth != viewportWidth || gameCamera->screenHeight != viewportHeight))
 	{
-		// Render second camera
-		glBindFramebuffer(GL_FRAMEBUFFER, fboGame);
-		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		gameCamera->screenWidth = viewportWidth;
+		gameCamera->screenHeight = viewportHeight;
+		gameCamera->frustumNeedsUpdate = true;
+	}
+
+	// Both cameras are culled and recorded at the same time. Each one only writes its
+	// own view, counters and frustum flag, the rest of the scene is read-only here. The registry
+	// list is rebuilt lazily, so it is built before the jobs read it.
+	app->scene->sceneRegistry.GetObjects();
 
-		glMatrixMode(GL_PROJECTION);
-		glLoadIdentity();
+	JobCounter gameCulling;
+	if (gameCamera != nullptr)
+		app->jobs.Submit([this, &snapshot, gameCamera]() { FillView(snapshot.gameView, gameCamera, false, snapshot); }, &gameCulling);
 
-		projectionMatrix = app->scene->activeGameCamera->GetProjectionMatrix();
-		glLoadMatrixf(glm::value_ptr(projectionMatrix));
+	FillView(snapshot.sceneView, app->scene->sceneCamera, true, snapshot);
 
-		glMatrixMode(GL_MODELVIEW);
-		glLoadIdentity();
+	app->jobs.Wait(gameCulling);
+}
+
+void ModuleRenderer3D::FillView(RenderView& view, ComponentCamera* camera, bool editorView, const RenderSnapshot& settings) const
+{
+	camera->UpdateVisibility();
+
+	camera->meshCount = 0;
+	camera->vertexCount = 0;
+	camera->triangleCount = 0;
+	camera->clusterCount = 0;
+	camera->visibleClusterCount = 0;
+
+	view.enabled = true;
+	view.editorView = editorView;
+	view.projection = camera->GetProjectionMatrix();
+	view.view = camera->GetViewMatrix();
+	view.cameraPosition = glm::vec3(glm::inverse(view.view)[3]);
+	view.cullBackfaces = settings.cullFace;
+	view.width = viewportWidth;
+	view.height = viewportHeight;
+
+	for (ComponentMesh* mesh : renderables)
+	{
+		if (!mesh->inActiveHierarchy)
+			continue;
 
-		viewMatrix = app->scene->activeGameCamera->GetViewMatrix();
-		glLoadMatrixf(glm::value_ptr(viewMatrix));
+		if (!(editorView ? mesh->gameObject->isOctreeInSceneFrustum : mesh->gameObject->isOctreeInGameFrustum))
+			continue;
 
-		DrawQueuedMeshes(app->scene->activeGameCamera);
+		// Merged into a static cluster, only the editor decorations are drawn per object
+		if (staticBatcher.Contains(mesh->gameObject))
+		{
+			if (editorView)
+				mesh->Submit(camera, view, true);
+			continue;
+		}
+
+		mesh->Submit(camera, view);
 	}
 
-	glBindFramebuffer(GL_FRAMEBUFFER, 0);
-	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+	for (const StaticCluster& cluster : staticBatcher.GetClusters())
+	{
+		if (!camera->IsAABBInFrustum(cluster.bounds))
+			continue;
 
-	app->editor->DrawEditor();
+		camera->meshCount += cluster.objectCount;
+		camera->vertexCount += cluster.mesh->verticesCount;
+		camera->triangleCount += cluster.mesh->indicesCount / 3;
 
-	SDL_GL_SwapWindow(app->window->window);
+		RenderItem item;
+		item.mesh = cluster.mesh.get();
+		item.textureId = cluster.textureId;
 
-	meshQueue.clear();
+		const glm::vec3 center = (cluster.bounds.min + cluster.bounds.max) * 0.5f;
+		const float depth = -(view.view * glm::vec4(center, 1.0f)).z;
+		item.sortKey = MakeSortKey(RenderPass::GEOMETRY, item.textureId, item.mesh, 0, depth);
 
-	return true;
+		view.items.push_back(item);
+	}
+
+	view.Sort();
+	view.BuildBatches(MIN_INSTANCES);
+	view.Record(settings);
 }
 
-void ModuleRenderer3D::DrawQueuedMeshes(ComponentCamera* camera) const
+void ModuleRenderer3D::ExecuteSnapshot(const RenderSnapshot& snapshot, int target)
 {
-	for (ComponentMesh* mesh : meshQueue)
+	if (snapshot.uploadFence != nullptr)
 	{
-		if (camera == app->scene->sceneCamera ? mesh->gameObject->isOctreeInSceneFrustum : mesh->gameObject->isOctreeInGameFrustum)
-			mesh->Draw(camera);
+		glWaitSync(snapshot.uploadFence, 0, GL_TIMEOUT_IGNORED);
+		glDeleteSync(snapshot.uploadFence);
 	}
+
+	glBackend.state.stats = RenderStats();
+
+	glBackend.target = &sceneTargets[target];
+	glBackend.Execute(snapshot.sceneView.commands, snapshot);
+
+	if (snapshot.gameView.enabled)
+	{
+		glBackend.target = &gameTargets[target];
+		glBackend.Execute(snapshot.gameView.commands, snapshot);
+	}
+
+	glBackend.target = nullptr;
+
+	if (snapshot.multiDraw)
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
 }
 
-bool ModuleRenderer3D::CleanUp()
+void ModuleRenderer3D::ExecuteHeadless(const RenderSnapshot& snapshot)
 {
-	LOG(LogType::LOG_INFO, "Destroying 3D Renderer");
+	nullBackend.stats = RenderStats();
+	nullBackend.Execute(snapshot.sceneView.commands, snapshot);
+	if (snapshot.gameView.enabled)
+		nullBackend.Execute(snapshot.gameView.commands, snapshot);
+	renderStats = nullBackend.stats;
 
-	glDeleteFramebuffers(1, &fboScene);
-	glDeleteTextures(1, &fboSceneTexture);
-	glDeleteRenderbuffers(1, &rboScene);
+	if (!app->headlessRunner.GetCommandsPath().empty())
+	{
+		commandRecorder.Clear();
+		commandRecorder.Execute(snapshot.sceneView.commands, snapshot);
+		if (snapshot.gameView.enabled)
+			commandRecorder.Execute(snapshot.gameView.commands, snapshot);
+	}
+}
 
-	glDeleteFramebuffers(1, &fboGame);
-	glDeleteTextures(1, &fboGameTexture);
-	glDeleteRenderbuffers(1, &rboGame);
+void ModuleRenderer3D::StartRenderThread()
+{
+	// The new context shares textures and buffers with the main one, which keeps
+	// uploading resources and drawing the editor
+	SDL_GL_SetAttribute(SDL_GL_SHARE_WITH_CURRENT_CONTEXT, 1);
+	renderContext = SDL_GL_CreateContext(app->window->window);
+	SDL_GL_MakeCurrent(app->window->window, app->window->context);
 
-	return true;
+	if (renderContext == nullptr)
+	{
+		LOG(LogType::LOG_WARNING, "Could not create render thread context, rendering on the main thread. SDL_Error: %s", SDL_GetError());
+		threadedRendering = false;
+		return;
+	}
+
+	stopRenderThread = false;
+	renderThread = std::thread(&ModuleRenderer3D::RenderThreadMain, this);
 }
 
-void ModuleRenderer3D::OnResize(int width, int height)
+void ModuleRenderer3D::StopRenderThread()
 {
-	glViewport(0, 0, width, height);
+	if (!renderThread.joinable())
+		return;
 
-	app->scene->sceneCamera->screenWidth = width;
-	app->scene->sceneCamera->screenHeight = height;
+	{
+		std::lock_guard<std::mutex> lock(renderMutex);
+		stopRenderThread = true;
+	}
+	renderCondition.notify_all();
+	renderThread.join();
 
-	glMatrixMode(GL_PROJECTION);
-	glLoadIdentity();
+	if (renderFence != nullptr)
+	{
+		glDeleteSync(renderFence);
+		renderFence = nullptr;
+	}
 
-	glm::mat4 projectionMatrix = app->scene->sceneCamera->GetProjectionMatrix();
-	glLoadMatrixf(glm::value_ptr(projectionMatrix));
+	SDL_GL_DeleteContext(renderContext);
+	renderContext = nullptr;
+}
 
-	glMatrixMode(GL_MODELVIEW);
-	glLoadIdentity();
+void ModuleRenderer3D::RenderThreadMain()
+{
+	SDL_GL_MakeCurrent(app->window->window, renderContext);
+	InitRenderState();
+
+	std::unique_lock<std::mutex> lock(renderMutex);
+	while (true)
+	{
+		renderCondition.wait(lock, [this] { return pendingSnapshot != nullptr || stopRenderThread; });
+		if (pendingSnapshot == nullptr)
+			break;
 
-	if (fboScene > 0)
-		glDeleteFramebuffers(1, &fboScene);
+		const RenderSnapshot* snapshot = pendingSnapshot;
+		const int target = pendingTarget;
+		lock.unlock();
 
-	if (fboSceneTexture > 0)
-		glDeleteTextures(1, &fboSceneTexture);
+		const Uint64 start = SDL_GetPerformanceCounter();
 
-	if (rboScene > 0)
-		glDeleteRenderbuffers(1, &rboScene);
+		ExecuteSnapshot(*snapshot, target);
 
-	if (fboGame > 0)
-		glDeleteFramebuffers(1, &fboGame);
+		GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		glFlush();
 
-	if (fboGameTexture > 0)
-		glDeleteTextures(1, &fboGameTexture);
+		const float elapsedMs = static_cast<float>(SDL_GetPerformanceCounter() - start) * 1000.0f / SDL_GetPerformanceFrequency();
 
-	if (rboGame > 0)
-		glDeleteRenderbuffers(1, &rboGame);
+		lock.lock();
+		if (renderFence != nullptr)
+			glDeleteSync(renderFence);
+		renderFence = fence;
+		completedTarget = target;
+		completedRenderMs = elapsedMs;
+		completedStats = glBackend.state.stats;
+		pendingSnapshot = nullptr;
+		renderCondition.notify_all();
+	}
+	lock.unlock();
+
+	// Framebuffers are not shared between contexts, they die with this one
+	for (int i = 0; i < 2; ++i)
+	{
+		GLRenderBackend::DestroyRenderTarget(sceneTargets[i]);
+		GLRenderBackend::DestroyRenderTarget(gameTargets[i]);
+	}
+	glBackend.instanceRenderer.Destroy();
+	glBackend.shaders.Destroy();
+	glBackend.debugRenderer.Destroy();
+	GeometryPool::Get().ReleaseVertexArrays();
 
-	CreateFramebuffer();
+	SDL_GL_MakeCurrent(app->window->window, nullptr);
 }
 
-void ModuleRenderer3D::CreateFramebuffer()
+void ModuleRenderer3D::WaitForRenderThread()
 {
-	glGenFramebuffers(1, &fboScene);
-	glBindFramebuffer(GL_FRAMEBUFFER, fboScene);
-
-	glGenTextures(1, &fboSceneTexture);
-	glBindTexture(GL_TEXTURE_2D, fboSceneTexture);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, static_cast<GLsizei>(app->editor->sceneWindow->windowSize.x),
-		static_cast<GLsizei>(app->editor->sceneWindow->windowSize.y), 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
-	glBindTexture(GL_TEXTURE_2D, 0);
-	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, fboSceneTexture, 0);
-
-	glGenRenderbuffers(1, &rboScene);
-	glBindRenderbuffer(GL_RENDERBUFFER, rboScene);
-	glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8,
-		static_cast<GLsizei>(app->editor->sceneWindow->windowSize.x), static_cast<GLsizei>(app->editor->sceneWindow->windowSize.y));
-	glBindRenderbuffer(GL_RENDERBUFFER, 0);
-	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, rboScene);
-
-	if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
-		LOG(LogType::LOG_ERROR, "Scene Framebuffer is not complete!");
-	}
-
-	glGenFramebuffers(1, &fboGame);
-	glBindFramebuffer(GL_FRAMEBUFFER, fboGame);
-
-	glGenTextures(1, &fboGameTexture);
-	glBindTexture(GL_TEXTURE_2D, fboGameTexture);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, static_cast<GLsizei>(app->editor->sceneWindow->windowSize.x), 
-		static_cast<GLsizei>(app->editor->sceneWindow->windowSize.y), 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
-	glBindTexture(GL_TEXTURE_2D, 0);
-	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, fboGameTexture, 0);
-
-	glGenRenderbuffers(1, &rboGame);
-	glBindRenderbuffer(GL_RENDERBUFFER, rboGame);
-	glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, 
-		static_cast<GLsizei>(app->editor->sceneWindow->windowSize.x), static_cast<GLsizei>(app->editor->sceneWindow->windowSize.y));
-	glBindRenderbuffer(GL_RENDERBUFFER, 0);
-	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, rboGame);
-
-	if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
-		LOG(LogType::LOG_ERROR, "Game Framebuffer is not complete!");
+	const Uint64 start = SDL_GetPerformanceCounter();
+
+	GLsync fence = nullptr;
+	{
+		std::unique_lock<std::mutex> lock(renderMutex);
+		renderCondition.wait(lock, [this] { return pendingSnapshot == nullptr; });
+
+		fence = renderFence;
+		renderFence = nullptr;
+		renderThreadMs = completedRenderMs;
+		renderStats = completedStats;
 	}
 
-	glBindFramebuffer(GL_FRAMEBUFFER, 0);
-}
\ No newline at end of file
+	renderWaitMs = static_cast<float>(SDL_GetPerformanceCounter() - start) * 1000.0f / SDL_GetPerformanceFrequency();
+
+	if (fence != nullptr)
+	{
+		// The editor samples the finished targets, make the main context wait for them on the GPU
+		glWaitSync(fence, 0, GL_TIMEOUT_IGNORED);
+		glDeleteSync(fence);
+		displayedTarget = completedTarget;
+	}
+}
+
+void ModuleRenderer3D::OnSceneEvents(const std::vector<SceneEvent>& events)
+{
+	for (const SceneEvent& event : events)
+	{
+		if (event.type == SceneEventType::OBJECT_DESTROYED)
+		{
+			RemoveRenderable(event.gameObject);
+		}
+		else if ((event.type == SceneEventType::COMPONENT_ADDED || event.type == SceneEventType::COMPONENT_REMOVED)
+			&& event.componentType == ComponentType::MESH)
+		{
+			GameObject* gameObject = app->scene->sceneRegistry.Resolve(event);
+			if (gameObject == nullptr)
+				continue;
+
+			if (gameObject->HasComponents(SignatureOf(ComponentType::MESH)))
+				AddRenderable(gameObject->mesh);
+			else
+				RemoveRenderable(gameObject);
+		}
+	}
+}
+
+void ModuleRenderer3D::AddRenderable(ComponentMesh* mesh)
+{
+	if (renderableIndex.find(mesh->gameObject) != renderableIndex.end())
+		return;
+
+	renderableIndex[mesh->gameObject] = renderables.size();
+	renderables.push_back(mesh);
+	renderableOwners.push_back(mesh->gameObject);
+}
+
+void ModuleRenderer3D::RemoveRenderable(const GameObject* gameObject)
+{
+	auto it = renderableIndex.find(gameObject);
+	if (it == renderableIndex.end())
+		return;
+
+	const size_t index = it->second;
+	renderableIndex.erase(it);
+
+	// Any of the meshes may be dangling already (children are destroyed before the
+	// parent's event is handled), so the moved entry is found through its owner
+	if (index != renderables.size() - 1)
+	{
+		renderables[index] = renderables.back();
+		renderableOwners[index] = renderableOwners.back();
+		renderableIndex[renderableOwners[index]] = index;
+	}
+	renderables.pop_back();
+	renderableOwners.pop_back();
+}
+
+bool ModuleRenderer3D::CleanUp()
+{
+	LOG(LogType::LOG_INFO, "Destroying 3D Renderer");
+
+	if (renderContext != nullptr)
+	{
+		StopRenderThread();
+	}
+	else
+	{
+		for (int i = 0; i < 2; ++i)
+		{
+			GLRenderBackend::DestroyRenderTarget(sceneTargets[i]);
+			GLRenderBackend::DestroyRenderTarget(gameTargets[i]);
+		}
+		glBackend.instanceRenderer.Destroy();
+		glBackend.shaders.Destroy();
+		glBackend.debugRenderer.Destroy();
+		GeometryPool::Get().ReleaseVertexArrays();
+	}
+
+	const std::string& commandsPath = app->headlessRunner.GetCommandsPath();
+	if (app->IsHeadless() && !commandsPath.empty())
+	{
+		std::ofstream file(commandsPath);
+		if (file.is_open())
+			file << commandRecorder.Dump();
+		else
+			LOG(LogType::LOG_ERROR, "Could not write render commands to %s", commandsPath.c_str());
+	}
+
+	staticBatcher.Clear();
+	GeometryPool::Get().Destroy();
+
+	return true;
+}
+
+void ModuleRenderer3D::OnResize(int width, int height)
+{
+	viewportWidth = width;
+	viewportHeight = height;
+
+	// Both views are drawn at the viewport size
+	for (ComponentCamera* camera : { app->scene->sceneCamera, app->scene->activeGameCamera })
+	{
+		if (camera == nullptr)
+			continue;
+
+		camera->screenWidth = width;
+		camera->screenHeight = height;
+		camera->frustumNeedsUpdate = true;
+	}
+}
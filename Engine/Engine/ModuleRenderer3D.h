@@ -5,42 +5,124 @@
 
 #include <SDL2/SDL_video.h>
 #include <GL/glew.h>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 #include "ComponentMesh.h"
+#include "RenderSnapshot.h"
+#include "RenderState.h"
+#include "GLRenderBackend.h"
+#include "StaticBatcher.h"
+#include "SceneEvents.h"
 
 #define CHECKERS_WIDTH 128*2
 #define CHECKERS_HEIGHT 128*2
 
-class ModuleRenderer3D : public Module
+// Fewer copies of a mesh than this are cheaper to draw one by one
+#define MIN_INSTANCES 4
+
+class ModuleRenderer3D : public Module, public SceneEventListener
 {
 public:
 	ModuleRenderer3D(App* app);
 	~ModuleRenderer3D();
 
+	std::vector<Module*> GetDependencies() const override;
 	bool Awake();
 	bool PreUpdate(float dt);
 	bool PostUpdate(float dt);
 	bool CleanUp();
 
+	void OnSceneEvents(const std::vector<SceneEvent>& events) override;
+
 	void OnResize(int width, int height);
-	void CreateFramebuffer();
-	void DrawQueuedMeshes(ComponentCamera* camera) const;
 
 	bool updateFramebuffer = false;
 
+	// Scene passes run on their own thread with a shared context. Falls back to the
+	// main thread when the shared context cannot be created.
+	bool threadedRendering = true;
+
+	float renderThreadMs = 0.0f;
+	float renderWaitMs = 0.0f;
+
+	// Draws and GL state changes of the last finished frame
+	RenderStats renderStats;
+
+	StaticBatcher staticBatcher;
+
 public:
 	GLubyte checkerImage[CHECKERS_WIDTH][CHECKERS_HEIGHT][4];
 	unsigned int checkerTextureId;
 
 	Grid grid;
 
-	GLuint fboScene;
+	// Textures of the render targets shown by the editor this frame
 	GLuint fboSceneTexture;
-	GLuint rboScene;
-	GLuint fboGame;
 	GLuint fboGameTexture;
-	GLuint rboGame;
 
-	std::vector<ComponentMesh*> meshQueue;
+	std::vector<ComponentMesh*> renderables;
+
+private:
+	void AddRenderable(ComponentMesh* mesh);
+	void RemoveRenderable(const GameObject* gameObject);
+
+	bool InitRenderState() const;
+
+	void BuildSnapshot(RenderSnapshot& snapshot);
+	// Adds the grid and octree to ModuleDebugDraw and moves the frame's shapes into the snapshot
+	void TakeDebugDraw(RenderSnapshot& snapshot);
+	void CullViews(RenderSnapshot& snapshot) const;
+	void FillView(RenderView& view, ComponentCamera* camera, bool editorView, const RenderSnapshot& settings) const;
+
+	void ExecuteSnapshot(const RenderSnapshot& snapshot, int target);
+	void ExecuteHeadless(const RenderSnapshot& snapshot);
+
+	void StartRenderThread();
+	void StopRenderThread();
+	void RenderThreadMain();
+	void WaitForRenderThread();
+
+private:
+	std::unordered_map<const GameObject*, size_t> renderableIndex;
+	// Owner of each renderable, never read through the mesh which may be freed
+	std::vector<const GameObject*> renderableOwners;
+
+	// Reused every frame by TakeDebugDraw
+	DebugDrawList sceneDebugDraw;
+	std::vector<AABB> octreeBounds;
+
+	int viewportWidth = 0;
+	int viewportHeight = 0;
+
+	// Two targets per view: the editor shows one while the render thread draws the other
+	RenderTarget sceneTargets[2];
+	RenderTarget gameTargets[2];
+	int displayedTarget = 0;
+
+	RenderSnapshot snapshots[2];
+	int writeSnapshot = 0;
+
+	// Replays the recorded views on the thread that executes snapshots
+	GLRenderBackend glBackend;
+
+	// Headless runs count the recorded draws, and keep the last frame's commands when
+	// asked to dump them
+	NullRenderBackend nullBackend;
+	RecordingRenderBackend commandRecorder;
+
+	SDL_GLContext renderContext = nullptr;
+	std::thread renderThread;
+	std::mutex renderMutex;
+	std::condition_variable renderCondition;
+	const RenderSnapshot* pendingSnapshot = nullptr;
+	int pendingTarget = 0;
+	int completedTarget = 0;
+	float completedRenderMs = 0.0f;
+	RenderStats completedStats;
+	GLsync renderFence = nullptr;
+	bool stopRenderThread = false;
 };
\ No newline at end of file
@@ -5,7 +5,7 @@
 #include "App.h"
 #include "Model.h"
 
-ModuleResources::ModuleResources(App* app) : Module(app)
+ModuleResources::ModuleResources(App* app) : Module(app, "Resources")
 {
 }
 
@@ -13,6 +13,11 @@ ModuleResources::~ModuleResources()
 {
 }
 
+std::vector<Module*> ModuleResources::GetDependencies() const
+{
+	return { app->fileSystem };
+}
+
 bool ModuleResources::Awake()
 {
 	return true;
@@ -36,6 +41,10 @@ bool ModuleResources::CleanUp()
 	resources.clear();
 	resourceUsageCount.clear();
 
+	// The renderer has stopped drawing by now
+	while (!retiredResources.empty())
+		ReleaseRetired();
+
 	return true;
 }
 
@@ -140,7 +149,7 @@ void ModuleResources::ModifyResourceUsageCount(Resource* resource, int delta)
 
 	//RemoveUnusedResource(resource);
 
-	app->editor->resourcesWindow->UpdateResources();
+	app->scene->sceneEvents.Record(SceneEventType::RESOURCES_CHANGED, nullptr);
 }
 
 void ModuleResources::RemoveUnusedResource(Resource* resource)
@@ -151,10 +160,21 @@ void ModuleResources::RemoveUnusedResource(Resource* resource)
 		if (it != resources.end())
 		{
 			resources.erase(it);
-		}
 
-		delete resource;
+			// Snapshots in flight may still point at it, deleted in ReleaseRetired
+			retiredResources.push_back(resource);
+		}
 
 		resourceUsageCount.erase(resource);
 	}
 }
+
+void ModuleResources::ReleaseRetired()
+{
+	// Deleting a mesh may retire its model, which waits for the next call
+	std::vector<Resource*> released;
+	released.swap(retiredResources);
+
+	for (Resource* resource : released)
+		delete resource;
+}
@@ -13,6 +13,7 @@ public:
 	ModuleResources(App* app);
 	virtual ~ModuleResources();
 
+	std::vector<Module*> GetDependencies() const override;
 	bool Awake();
 	bool CleanUp();
 
@@ -29,7 +30,14 @@ public:
 	void ModifyResourceUsageCount(Resource* resource, int delta);
 	void RemoveUnusedResource(Resource* resource);
 
+	// Deletes the resources removed so far. Called by the renderer once no snapshot
+	// recorded before their removal is still executing.
+	void ReleaseRetired();
+
 private:
 	std::vector<Resource*> resources;
 	std::unordered_map<Resource*, int> resourceUsageCount;
+
+	// Removed resources the render thread may still draw, with their geometry ranges
+	std::vector<Resource*> retiredResources;
 };
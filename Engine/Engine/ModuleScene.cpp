@@ -1,21 +1,151 @@
 #include "ModuleScene.h"
 #include "App.h"
 #include "ScriptMoveInCircle.h"
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 
-ModuleScene::ModuleScene(App* app) : Module(app), sceneBounds(glm::vec3(-15.0f), glm::vec3(15.0f))
+// Builds a new octree a slice at a time. The current one keeps being used (and updated
+// by scene events) until the new one is complete and swapped in.
+class OctreeRebuildTask : public BackgroundTask
+{
+public:
+	OctreeRebuildTask(ModuleScene* scene) : BackgroundTask("Rebuilding octree", TaskMode::MAIN_THREAD), scene(scene) {}
+
+	bool Step(int64_t deadlineNs) override
+	{
+		if (phase == Phase::GATHER)
+		{
+			for (const GameObject* gameObject : scene->sceneRegistry.GetObjects())
+			{
+				SceneEvent handle;
+				handle.registrySlot = gameObject->GetRegistrySlot();
+				handle.registrySerial = gameObject->GetRegistrySerial();
+				handles.push_back(handle);
+			}
+			phase = Phase::BOUNDS;
+		}
+
+		for (; next < handles.size(); ++next)
+		{
+			if ((next & 15) == 0 && Timer::NowNs() >= deadlineNs)
+			{
+				SetProgress((phase == Phase::INSERT ? handles.size() + next : next) / (2.0f * handles.size()));
+				return false;
+			}
+
+			GameObject* gameObject = scene->sceneRegistry.Resolve(handles[next]);
+			if (gameObject == nullptr)
+				continue;
+
+			if (phase == Phase::INSERT)
+			{
+				ModuleScene::InsertIntoOctree(*octree, gameObject);
+				continue;
+			}
+
+			const AABB objectAABB = gameObject->GetAABB();
+			if (firstObject)
+			{
+				bounds = objectAABB;
+				firstObject = false;
+			}
+			else
+			{
+				bounds.min = glm::min(bounds.min, objectAABB.min);
+				bounds.max = (glm::max)(bounds.max, objectAABB.max);
+			}
+		}
+
+		if (phase == Phase::BOUNDS)
+		{
+			octree = std::make_unique<Octree>(bounds, scene->octreeMaxDepth, scene->octreeMaxObjects);
+			phase = Phase::INSERT;
+			next = 0;
+			return Step(deadlineNs);
+		}
+
+		return true;
+	}
+
+	void Complete() override
+	{
+		// Catch up with what changed since the objects were gathered
+		for (GameObject* gameObject : destroyed)
+			octree->Remove(gameObject);
+
+		for (const SceneEvent& event : changed)
+		{
+			GameObject* gameObject = scene->sceneRegistry.Resolve(event);
+			if (gameObject == nullptr)
+				continue;
+
+			octree->Remove(gameObject);
+			if (!ModuleScene::InsertIntoOctree(*octree, gameObject))
+				scene->octreeNeedsUpdate = true;
+		}
+
+		delete scene->sceneOctree;
+		scene->sceneOctree = octree.release();
+		scene->octreeRebuild = nullptr;
+
+		scene->sceneCamera->frustumNeedsUpdate = true;
+		if (scene->activeGameCamera) scene->activeGameCamera->frustumNeedsUpdate = true;
+	}
+
+	void Record(const std::vector<SceneEvent>& events)
+	{
+		for (const SceneEvent& event : events)
+		{
+			if (event.type == SceneEventType::OBJECT_DESTROYED)
+				destroyed.push_back(event.gameObject);
+			else if (event.type != SceneEventType::RESOURCES_CHANGED && event.type != SceneEventType::STATE_CHANGED)
+				changed.push_back(event);
+		}
+	}
+
+private:
+	enum class Phase { GATHER, BOUNDS, INSERT };
+
+	ModuleScene* scene = nullptr;
+	Phase phase = Phase::GATHER;
+
+	std::vector<SceneEvent> handles;
+	size_t next = 0;
+
+	AABB bounds;
+	bool firstObject = true;
+	std::unique_ptr<Octree> octree;
+
+	std::vector<GameObject*> destroyed;
+	std::vector<SceneEvent> changed;
+};
+
+static const char* STARTUP_MODELS[] = { "Assets/Models/Street environment_V01.fbx", "Engine/Primitives/Capsule.fbx" };
+
+ModuleScene::ModuleScene(App* app) : Module(app, "Scene"), sceneBounds(glm::vec3(-15.0f), glm::vec3(15.0f))
 {
 	sceneCamera = new ComponentCamera(nullptr);
+
+	sceneEvents.Subscribe(this);
 }
 
 ModuleScene::~ModuleScene()
 {
 }
 
+std::vector<Module*> ModuleScene::GetDependencies() const
+{
+	return { app->fileSystem, app->resources, app->importer };
+}
+
 bool ModuleScene::Awake()
 {
+	if (app->headlessRunner.GetScenePath().empty())
+		ImportStartupModels();
+
 	root = CreateGameObject("Untitled Scene", nullptr);
+	sceneRegistry.SetRoot(root);
 
 	GameObject* camera = CreateGameObject("Camera", root);
 	activeGameCamera = new ComponentCamera(camera);
@@ -31,15 +161,19 @@ bool ModuleScene::Awake()
 
 bool ModuleScene::Start()
 {
-	app->importer->ImportFile("Assets/Models/Street environment_V01.fbx", true);
+	// Headless runs load the requested scene instead of the startup models
+	if (!app->headlessRunner.GetScenePath().empty())
+	{
+		currentScene = app->headlessRunner.GetScenePath();
+		LoadScene(currentScene);
+		return true;
+	}
+
+	app->importer->LoadToScene(GetStartupModel(STARTUP_MODELS[0]), ResourceType::MODEL);
 	//LoadScene("Assets/Scenes/Scene.scene");
 	app->editor->selectedGameObject = app->scene->root->children[0];
 
-	std::string fullPath = "Engine/Primitives/Capsule.fbx";
-
-	Resource* resource = app->resources->FindResourceInLibrary(fullPath, ResourceType::MODEL);
-	if (!resource)
-		resource = app->importer->ImportFileToLibrary(fullPath, ResourceType::MODEL);
+	Resource* resource = GetStartupModel(STARTUP_MODELS[1]);
 
 	app->resources->ModifyResourceUsageCount(resource, 1);
 	app->importer->modelImporter->LoadModel(resource, app->scene->root);
@@ -54,97 +188,324 @@ bool ModuleScene::Start()
 	return true;
 }
 
-bool ModuleScene::Update(float dt)
+void ModuleScene::ImportStartupModels()
 {
-	if (octreeNeedsUpdate)
+	// Parsing with assimp is the slowest part of the boot, only models without an up to
+	// date library file are imported, in parallel. Start reads the library files back.
+	std::vector<const char*> outdated;
+	for (const char* assetPath : STARTUP_MODELS)
 	{
-		UpdateOctree();
-		sceneCamera->frustumNeedsUpdate = true;
-		activeGameCamera->frustumNeedsUpdate = true;
-		octreeNeedsUpdate = false;
+		const std::string fileName = app->fileSystem->GetFileNameWithoutExtension(assetPath);
+		const std::string libraryPath = app->resources->CreateLibraryFileDir(fileName, ResourceType::MODEL);
+		if (!app->fileSystem->IsUpToDate(libraryPath, assetPath))
+			outdated.push_back(assetPath);
 	}
 
-	root->Update();
+	app->jobs.ParallelFor(outdated.size(), 1, [this, &outdated](size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; ++i)
+				app->importer->modelImporter->SaveModel(outdated[i]);
+		});
+}
+
+Resource* ModuleScene::GetStartupModel(const char* assetPath) const
+{
+	Resource* resource = app->resources->FindResourceInLibrary(assetPath, ResourceType::MODEL);
+	if (!resource)
+		resource = app->resources->CreateResource(assetPath, ResourceType::MODEL);
+
+	return resource;
+}
+
+bool ModuleScene::Update(float dt)
+{
+	// Picks up what the editor changed last frame before scripts read activity and transforms
+	UpdateTransforms();
+	UpdateScripts();
+	UpdateTransforms();
 
 	if (app->time.GetState() == GameState::STEP)
 		app->time.SetState(GameState::PAUSE);
 
-	if (app->input->GetKey(SDL_SCANCODE_LCTRL) == KEY_REPEAT && app->input->GetKey(SDL_SCANCODE_S) == KEY_DOWN)
+	// Input is never awoken in headless runs
+	if (!app->IsHeadless())
 	{
-		currentScene = "Assets/Scenes/" + root->name + ".scene";
-		SaveScene(currentScene);
-	}
-	if (app->input->GetKey(SDL_SCANCODE_LCTRL) == KEY_REPEAT && app->input->GetKey(SDL_SCANCODE_O) == KEY_DOWN)
-	{
-		OpenScene();
+		if (app->input->GetKey(SDL_SCANCODE_LCTRL) == KEY_REPEAT && app->input->GetKey(SDL_SCANCODE_S) == KEY_DOWN)
+		{
+			currentScene = "Assets/Scenes/" + root->name + ".scene";
+			SaveScene(currentScene);
+		}
+		if (app->input->GetKey(SDL_SCANCODE_LCTRL) == KEY_REPEAT && app->input->GetKey(SDL_SCANCODE_O) == KEY_DOWN)
+		{
+			OpenScene();
+		}
+		if (app->input->GetKey(SDL_SCANCODE_LCTRL) == KEY_REPEAT && app->input->GetKey(SDL_SCANCODE_N) == KEY_DOWN)
+		{
+			NewScene();
+		}
 	}
-	if (app->input->GetKey(SDL_SCANCODE_LCTRL) == KEY_REPEAT && app->input->GetKey(SDL_SCANCODE_N) == KEY_DOWN)
+
+	sceneEvents.Dispatch();
+
+	if (sceneEvents.GetLastDispatchCount() > 0 || app->time.GetState() == GameState::PLAY || app->time.GetState() == GameState::STEP)
+		app->RequestRedraw();
+
+	if (octreeNeedsUpdate && octreeRebuild == nullptr)
 	{
-		NewScene();
+		octreeRebuild = new OctreeRebuildTask(this);
+		app->tasks.Add(octreeRebuild);
+		octreeNeedsUpdate = false;
 	}
 
+	UpdateCameras();
+	UpdateMeshes();
+
 	return true;
 }
 
-void ModuleScene::UpdateOctree() const
+void ModuleScene::OnSceneEvents(const std::vector<SceneEvent>& events)
 {
-	AABB newBounds;
-	bool firstObject = true;
+	if (octreeRebuild != nullptr)
+		octreeRebuild->Record(events);
 
-	std::vector<GameObject*> objects;
-	CollectObjects(root, objects);
+	if (octreeNeedsUpdate)
+		return;
+
+	bool octreeChanged = false;
+	changedObjects.clear();
 
-	for (const auto& object : objects)
+	// Removals go first: a new object may reuse the address of one destroyed this frame
+	for (const SceneEvent& event : events)
 	{
-		if (object != nullptr)
+		if (event.type == SceneEventType::OBJECT_DESTROYED)
 		{
-			if (firstObject)
-			{
-				newBounds = object->GetAABB();
-				firstObject = false;
-			}
-			else
-			{
-				newBounds.min = glm::min(newBounds.min, object->GetAABB().min);
-				newBounds.max = (glm::max)(newBounds.max, object->GetAABB().max);
-			}
+			sceneOctree->Remove(event.gameObject);
+			octreeChanged = true;
+		}
+		else if (event.type != SceneEventType::RESOURCES_CHANGED && event.type != SceneEventType::STATE_CHANGED)
+		{
+			GameObject* gameObject = sceneRegistry.Resolve(event);
+			if (gameObject != nullptr)
+				changedObjects.push_back(gameObject);
+		}
+	}
+
+	std::sort(changedObjects.begin(), changedObjects.end());
+	changedObjects.erase(std::unique(changedObjects.begin(), changedObjects.end()), changedObjects.end());
+
+	if (changedObjects.size() * 2 > sceneRegistry.GetObjectCount())
+	{
+		octreeNeedsUpdate = true;
+		return;
+	}
+
+	for (GameObject* gameObject : changedObjects)
+	{
+		sceneOctree->Remove(gameObject);
+		if (!InsertIntoOctree(*sceneOctree, gameObject))
+		{
+			octreeNeedsUpdate = true;
+			return;
 		}
+		octreeChanged = true;
 	}
 
-	sceneOctree->SetBounds(newBounds);
-	sceneOctree->Clear();
-	AddGameObjectToOctree(root);
+	if (octreeChanged)
+	{
+		sceneCamera->frustumNeedsUpdate = true;
+		if (activeGameCamera) activeGameCamera->frustumNeedsUpdate = true;
+	}
 }
 
-void ModuleScene::AddGameObjectToOctree(const GameObject* gameObject) const
+void ModuleScene::UpdateScripts()
 {
-	if (gameObject == nullptr)
+	if (!(app->time.GetState() == GameState::PLAY || app->time.GetState() == GameState::STEP))
 		return;
 
-	std::vector<GameObject*> objects;
-	CollectObjects(gameObject, objects);
+	scriptObjects.clear();
+	componentStorage.ForEach(SignatureOf(ComponentType::SCRIPT), [this](Archetype& archetype)
+		{
+			scriptObjects.insert(scriptObjects.end(), archetype.gameObjects.begin(), archetype.gameObjects.end());
+		});
 
-	for (const auto& object : objects)
+	// Rendering blends between the states before and after the last fixed step, the
+	// earlier steps of a long frame are already behind the displayed time
+	const int fixedSteps = app->time.GetFixedStepCount();
+	for (int step = 0; step < fixedSteps; ++step)
 	{
-		if (object != nullptr && object->GetAABB().min != glm::vec3(0,0,0) && object->GetAABB().max != glm::vec3(0,0,0))
+		if (step == fixedSteps - 1)
 		{
-			sceneOctree->Insert(object, object->GetAABB());
+			UpdateTransforms();
+			CaptureTransforms(true);
 		}
+
+		RunScripts(&ComponentScript::FixedUpdate);
+	}
+
+	// Update runs at the frame rate, its movement is applied on top of the blend
+	if (fixedSteps > 0)
+	{
+		UpdateTransforms();
+		CaptureTransforms(false);
+	}
+
+	RunScripts(&ComponentScript::Update);
+}
+
+void ModuleScene::RunScripts(void (ComponentScript::*method)())
+{
+	const size_t batchSize = static_cast<size_t>((std::max)(scriptBatchSize, 1));
+	const size_t batchCount = (scriptObjects.size() + batchSize - 1) / batchSize;
+	if (batchEvents.size() < batchCount)
+	{
+		batchEvents.resize(batchCount);
+		batchMainThreadScripts.resize(batchCount);
+	}
+
+	// Scripts only write to their own GameObject, transforms are propagated afterwards
+	app->jobs.ParallelFor(scriptObjects.size(), batchSize, [this, batchSize, method](size_t begin, size_t end)
+		{
+			const size_t batch = begin / batchSize;
+			sceneEvents.BeginDeferred(batchEvents[batch]);
+
+			for (size_t i = begin; i < end; ++i)
+			{
+				GameObject* gameObject = scriptObjects[i];
+				if (!gameObject->activeInHierarchy)
+					continue;
+
+				for (Component* component : gameObject->components)
+				{
+					if (component->type != ComponentType::SCRIPT)
+						continue;
+
+					if (component->IsThreadSafe())
+						(static_cast<ComponentScript*>(component)->*method)();
+					else
+						batchMainThreadScripts[batch].push_back(component);
+				}
+			}
+
+			sceneEvents.EndDeferred();
+		});
+
+	for (size_t batch = 0; batch < batchCount; ++batch)
+	{
+		sceneEvents.AppendDeferred(batchEvents[batch]);
+
+		for (Component* component : batchMainThreadScripts[batch])
+			(static_cast<ComponentScript*>(component)->*method)();
+
+		batchMainThreadScripts[batch].clear();
 	}
 }
 
-void ModuleScene::CollectObjects(const GameObject* gameObject, std::vector<GameObject*>& objects) const
+void ModuleScene::CaptureTransforms(bool previous)
 {
-	if (gameObject == nullptr)
+	if (previous)
+		transformCapture++;
+
+	componentStorage.ForEach(SignatureOf(ComponentType::TRANSFORM), [this, previous](Archetype& archetype)
+		{
+			for (Component* component : archetype.Column(ComponentType::TRANSFORM))
+			{
+				ComponentTransform* transform = static_cast<ComponentTransform*>(component);
+				if (previous)
+				{
+					transform->previousGlobalTransform = transform->globalTransform;
+					transform->previousCapture = transformCapture;
+				}
+				else
+				{
+					transform->fixedGlobalTransform = transform->globalTransform;
+					transform->fixedCapture = transformCapture;
+				}
+			}
+		});
+}
+
+static void PropagateTransform(ComponentTransform* transform, const ComponentTransform* parent, uint32_t pass)
+{
+	const bool parentChanged = parent != nullptr && parent->propagatedPass == pass;
+	if (!transform->updateTransform && !parentChanged)
 		return;
 
-	for (auto* child : gameObject->children)
+	if (transform->updateTransform)
+		transform->UpdateLocalTransform();
+
+	transform->UpdateGlobalTransform();
+	transform->propagatedPass = pass;
+}
+
+void ModuleScene::UpdateTransforms()
+{
+	transformPass++;
+
+	// Parents come before their children, so one linear pass carries every change down,
+	// rebuilding each transform at most once, and resolves inherited activity
+	root->activeInHierarchy = root->isActive;
+	PropagateTransform(root->transform, nullptr, transformPass);
+
+	for (GameObject* gameObject : sceneRegistry.GetObjects())
 	{
-		if (child->parent != nullptr)
-			objects.push_back(child);
+		const GameObject* parent = gameObject->parent;
+		gameObject->activeInHierarchy = gameObject->isActive && parent->activeInHierarchy;
+		PropagateTransform(gameObject->transform, parent->transform, transformPass);
+	}
+}
+
+void ModuleScene::UpdateCameras()
+{
+	componentStorage.ForEach(SignatureOf(ComponentType::CAMERA), [](Archetype& archetype)
+		{
+			const std::vector<Component*>& cameras = archetype.Column(ComponentType::CAMERA);
+			for (size_t i = 0; i < cameras.size(); ++i)
+			{
+				if (archetype.gameObjects[i]->activeInHierarchy)
+					cameras[i]->Update();
+			}
+		});
+}
+
+void ModuleScene::UpdateMeshes()
+{
+	const GameObject* selected = app->editor->selectedGameObject;
 
-		CollectObjects(child, objects);
+	// Parents are visited first, so each object only looks one level up
+	for (GameObject* gameObject : sceneRegistry.GetObjects())
+	{
+		const GameObject* parent = gameObject->parent;
+		gameObject->isParentSelected = parent == selected || parent->isParentSelected;
 	}
+
+	componentStorage.ForEach(SignatureOf(ComponentType::TRANSFORM) | SignatureOf(ComponentType::MESH), [selected](Archetype& archetype)
+		{
+			const std::vector<Component*>& meshes = archetype.Column(ComponentType::MESH);
+			for (size_t i = 0; i < meshes.size(); ++i)
+			{
+				GameObject* gameObject = archetype.gameObjects[i];
+
+				ComponentMesh* mesh = static_cast<ComponentMesh*>(meshes[i]);
+				mesh->drawOutline = gameObject->isParentSelected || gameObject == selected;
+
+				mesh->inActiveHierarchy = gameObject->activeInHierarchy;
+			}
+		});
+}
+
+bool ModuleScene::InsertIntoOctree(Octree& octree, GameObject* gameObject)
+{
+	const AABB objectAABB = gameObject->GetAABB();
+	if (objectAABB.min == glm::vec3(0, 0, 0) || objectAABB.max == glm::vec3(0, 0, 0))
+		return true;
+
+	// Objects leaving the current bounds need the octree to be rebuilt
+	const AABB bounds = octree.GetBounds();
+	if (glm::any(glm::lessThan(objectAABB.min, bounds.min)) || glm::any(glm::greaterThan(objectAABB.max, bounds.max)))
+		return false;
+
+	octree.Insert(gameObject, objectAABB);
+	return true;
 }
 
 bool ModuleScene::CleanUp()
@@ -164,7 +525,7 @@ GameObject* ModuleScene::CreateGameObject(const char* name, GameObject* parent)
 {
 	GameObject* gameObject = new GameObject(name, parent);
 
-	if (parent != nullptr) parent->children.push_back(gameObject);
+	if (parent != nullptr) gameObject->SetParent(parent);
 
 	return gameObject;
 }
@@ -177,18 +538,12 @@ void ModuleScene::SaveScene(const std::string& filePath)
 
 	sceneJson["name"] = root->name;
 
-	std::vector<GameObject*> objects;
-	CollectObjects(root, objects);
-
-	for (const auto& object : objects)
-	{
-		if (object != nullptr)
+	sceneRegistry.ForEach([&sceneJson](const GameObject* object)
 		{
 			nlohmann::json objectJson;
 			object->Serialize(objectJson);
 			sceneJson["objects"].push_back(objectJson);
-		}
-	}
+		});
 
 	nlohmann::json resourcesJson;
 	const auto& resources = app->resources->GetResources();
@@ -225,12 +580,9 @@ void ModuleScene::LoadScene(const std::string& filePath)
 
 	root->name = sceneJson["name"].get<std::string>();
 
-	for (auto* child : root->children) {
-		delete child;
-	}
-	root->children.clear();
-
-	app->renderer3D->meshQueue.clear();
+	// Each child detaches itself from root when deleted
+	while (!root->children.empty())
+		delete root->children.back();
 
 	app->editor->selectedGameObject = nullptr;
 
@@ -261,29 +613,49 @@ void ModuleScene::LoadScene(const std::string& filePath)
 		}
 	}
 
-	std::unordered_map<std::string, GameObject*> objectMap;
-	for (const auto& objectJson : sceneJson["objects"])
+	const auto& objectsJson = sceneJson["objects"];
+	std::vector<GameObject*> objects;
+	objects.reserve(objectsJson.size());
+
+	for (const auto& objectJson : objectsJson)
 	{
 		std::string name = objectJson["name"].get<std::string>();
-		std::string uuid = objectJson["uuid"].get<std::string>();
 		GameObject* object = CreateGameObject(name.c_str(), nullptr);
-		objectMap[uuid] = object;
+
+		// A bad or repeated UID keeps the one generated for the object, so entries never collide
+		const std::string& uidText = objectJson["uuid"].get_ref<const std::string&>();
+		UID uid;
+		if (!UID::FromString(uidText, uid))
+			LOG(LogType::LOG_WARNING, "Invalid UID '%s' for %s, a new one was generated", uidText.c_str(), name.c_str());
+		else if (sceneRegistry.Find(uid) != nullptr)
+			LOG(LogType::LOG_WARNING, "Duplicate UID %s for %s, a new one was generated", uidText.c_str(), name.c_str());
+		else
+			sceneRegistry.SetUID(object, uid);
+
+		objects.push_back(object);
 	}
 
-	for (const auto& objectJson : sceneJson["objects"])
+	for (size_t i = 0; i < objects.size(); ++i)
 	{
-		std::string name = objectJson["name"].get<std::string>();
-		std::string uuid = objectJson["uuid"].get<std::string>();
-		std::string parentUuid = objectJson["parent"].get<std::string>();
-		GameObject* object = objectMap[uuid];
+		const auto& objectJson = objectsJson[i];
+		GameObject* object = objects[i];
 
-		GameObject* parent = parentUuid.empty() ? root : objectMap[parentUuid];
-		if (parent && object)
+		const std::string& parentUidText = objectJson["parent"].get_ref<const std::string&>();
+		GameObject* parent = root;
+		UID parentUid;
+		if (!parentUidText.empty())
 		{
-			object->parent = parent;
-			parent->children.push_back(object);
+			parent = UID::FromString(parentUidText, parentUid) ? sceneRegistry.Find(parentUid) : nullptr;
+			if (parent == nullptr)
+			{
+				LOG(LogType::LOG_WARNING, "Parent %s of %s not found, placed under the scene root", parentUidText.c_str(), object->name.c_str());
+				parent = root;
+			}
 		}
 
+		if (parent && object)
+			object->SetParent(parent);
+
 		object->Deserialize(objectJson);
 	}
 }
@@ -316,10 +688,10 @@ void ModuleScene::OpenScene() const
 void ModuleScene::NewScene()
 {
 	delete root;
-	app->renderer3D->meshQueue.clear();
 	app->editor->selectedGameObject = nullptr;
 
 	root = CreateGameObject("Untitled Scene", nullptr);
+	sceneRegistry.SetRoot(root);
 
 	GameObject* camera = CreateGameObject("Camera", root);
 	activeGameCamera = new ComponentCamera(camera);
@@ -4,25 +4,31 @@
 #include "Module.h"
 #include "GameObject.h"
 #include "Octree.h"
+#include "ComponentStorage.h"
+#include "SceneRegistry.h"
 #include "Mesh.h"
 #include <nlohmann/json.hpp>
 
 class GameObject;
+class ComponentScript;
+class OctreeRebuildTask;
 
-class ModuleScene : public Module
+class ModuleScene : public Module, public SceneEventListener
 {
 public:
 	ModuleScene(App* app);
 	virtual ~ModuleScene();
 
+	std::vector<Module*> GetDependencies() const override;
 	bool Awake();
 	bool Start();
 
 	bool Update(float dt);
 	bool CleanUp();
 
+	void OnSceneEvents(const std::vector<SceneEvent>& events) override;
+
 	GameObject* CreateGameObject(const char* name, GameObject* parent);
-	void CollectObjects(const GameObject* gameObject, std::vector<GameObject*>& objects) const;
 
 	void SaveScene(const std::string& filePath);
 	void LoadScene(const std::string& filePath);
@@ -31,8 +37,20 @@ public:
 	void NewScene();
 
 private:
-	void UpdateOctree() const;
-	void AddGameObjectToOctree(const GameObject* gameObject) const;
+	void ImportStartupModels();
+	Resource* GetStartupModel(const char* assetPath) const;
+
+	void UpdateScripts();
+	void RunScripts(void (ComponentScript::*method)());
+	// Before the last fixed step when previous, after it otherwise
+	void CaptureTransforms(bool previous);
+	void UpdateTransforms();
+	void UpdateCameras();
+	void UpdateMeshes();
+
+	static bool InsertIntoOctree(Octree& octree, GameObject* gameObject);
+
+	friend class OctreeRebuildTask;
 
 public:
 	GameObject* root = nullptr;
@@ -50,4 +68,23 @@ public:
 	ComponentCamera* activeGameCamera = nullptr;
 
 	std::string currentScene;
+
+	ComponentStorage componentStorage;
+	SceneRegistry sceneRegistry;
+	SceneEventStream sceneEvents;
+
+	int scriptBatchSize = 64;
+
+	// Incremented every time transforms are captured before the last fixed step
+	uint32_t transformCapture = 0;
+	// Incremented by every UpdateTransforms, see ComponentTransform::propagatedPass
+	uint32_t transformPass = 0;
+
+private:
+	std::vector<GameObject*> changedObjects;
+	OctreeRebuildTask* octreeRebuild = nullptr;
+
+	std::vector<GameObject*> scriptObjects;
+	std::vector<std::vector<SceneEvent>> batchEvents;
+	std::vector<std::vector<Component*>> batchMainThreadScripts;
 };
\ No newline at end of file
@@ -1,7 +1,7 @@
 #include "ModuleWindow.h"
 #include "App.h"
 
-ModuleWindow::ModuleWindow(App* app) : Module(app), window(nullptr), screenSurface(nullptr), width(SCREEN_WIDTH), height(SCREEN_HEIGHT), context(nullptr)
+ModuleWindow::ModuleWindow(App* app) : Module(app, "Window"), window(nullptr), screenSurface(nullptr), width(SCREEN_WIDTH), height(SCREEN_HEIGHT), context(nullptr)
 {
 }
 
@@ -150,5 +150,4 @@ void ModuleWindow::RenderInitialScreen()
 	SDL_RenderFillRect(renderer, &rect);
 	SDL_RenderCopy(renderer, loadingBarTexture, nullptr, nullptr);
 	SDL_RenderPresent(renderer);
-	SDL_Delay(60);
 }
\ No newline at end of file
@@ -43,8 +43,8 @@ public:
 	int loadingBarWidth = 0;
 	int loadingBarPercentage = 0;
 
-	int width;
-	int height;
+	int width = SCREEN_WIDTH;
+	int height = SCREEN_HEIGHT;
 
 	bool fullscreen = WIN_FULLSCREEN;
 	bool borderless = WIN_BORDERLESS;
@@ -1,5 +1,6 @@
 #include "Octree.h"
 
+#include <algorithm>
 #include <iostream>
 
 #include "App.h"
@@ -17,14 +18,15 @@ void Octree::Insert(GameObject* object, const AABB& objectBounds)
     Insert(root.get(), object, objectBounds, 0);
 }
 
-void OctreeNode::UpdateIsOnFrustum(ComponentCamera* camera)
+void OctreeNode::UpdateIsOnFrustum(ComponentCamera* camera) const
 {
-    isOnFrustum = camera->IsAABBInFrustum(bounds);
+    // Children are inside this node, none of them can be visible if it is not
+    if (!camera->IsAABBInFrustum(bounds)) return;
 
+    const bool isSceneCamera = camera == app->scene->sceneCamera;
 	for (const auto& object : objects)
 	{
-        if (isOnFrustum)
-            (camera == app->scene->sceneCamera ? object->isOctreeInSceneFrustum : object->isOctreeInGameFrustum) = true;
+        (isSceneCamera ? object->isOctreeInSceneFrustum : object->isOctreeInGameFrustum) = true;
 	}
 
     if (IsLeaf()) return;
@@ -40,12 +42,10 @@ void OctreeNode::UpdateIsOnFrustum(ComponentCamera* camera)
 
 void Octree::UpdateAllNodesVisibility(ComponentCamera* camera) const
 {
-    std::vector<GameObject*> objects;
-    app->scene->CollectObjects(app->scene->root, objects);
-    for (const auto& object : objects)
+    const bool isSceneCamera = camera == app->scene->sceneCamera;
+    for (GameObject* object : app->scene->sceneRegistry.GetObjects())
     {
-        if (object != nullptr)
-			(camera == app->scene->sceneCamera ? object->isOctreeInSceneFrustum : object->isOctreeInGameFrustum) = false;
+		(isSceneCamera ? object->isOctreeInSceneFrustum : object->isOctreeInGameFrustum) = false;
     }
 
     if (root)
@@ -64,6 +64,7 @@ void Octree::Insert(OctreeNode* node, GameObject* object, const AABB& objectBoun
     if (node->IsLeaf() && (node->objects.size() < maxObjects || depth >= maxDepth))
     {
         node->objects.push_back(object);
+        objectNodes[object].push_back(node);
         return;
     }
 
@@ -76,6 +77,9 @@ void Octree::Insert(OctreeNode* node, GameObject* object, const AABB& objectBoun
 
         for (auto* existingObject : objectsToRedistribute)
         {
+            std::vector<OctreeNode*>& nodes = objectNodes[existingObject];
+            nodes.erase(std::remove(nodes.begin(), nodes.end(), node), nodes.end());
+
             AABB existingBounds = existingObject->GetAABB();
             for (auto& child : node->children)
             {
@@ -96,6 +100,19 @@ void Octree::Insert(OctreeNode* node, GameObject* object, const AABB& objectBoun
     }
 }
 
+void Octree::Remove(const GameObject* object)
+{
+    auto it = objectNodes.find(object);
+    if (it == objectNodes.end())
+        return;
+
+    // Objects can be stored in every leaf their bounds overlap
+    for (OctreeNode* node : it->second)
+        node->objects.erase(std::remove(node->objects.begin(), node->objects.end(), object), node->objects.end());
+
+    objectNodes.erase(it);
+}
+
 void Octree::Subdivide(OctreeNode* node)
 {
     glm::vec3 size = (node->bounds.max - node->bounds.min) * 0.5f;
@@ -123,6 +140,7 @@ bool Octree::Intersect(const AABB& a, const AABB& b) const
 void Octree::Clear()
 {
     ClearNode(root.get());
+    objectNodes.clear();
 }
 
 void Octree::ClearNode(OctreeNode* node)
@@ -142,59 +160,32 @@ void Octree::ClearNode(OctreeNode* node)
     }
 }
 
-void Octree::DrawAABB(const AABB& aabb, const glm::vec3& color) const
+void Octree::CollectBounds(std::vector<AABB>& bounds) const
 {
-    glm::vec3 vertices[8] = {
-        aabb.min,
-        glm::vec3(aabb.min.x, aabb.min.y, aabb.max.z),
-        glm::vec3(aabb.min.x, aabb.max.y, aabb.min.z),
-        glm::vec3(aabb.min.x, aabb.max.y, aabb.max.z),
-        glm::vec3(aabb.max.x, aabb.min.y, aabb.min.z),
-        glm::vec3(aabb.max.x, aabb.min.y, aabb.max.z),
-        glm::vec3(aabb.max.x, aabb.max.y, aabb.min.z),
-        aabb.max
-    };
-
-    unsigned int indices[24] = {
-        0, 1, 0, 2, 0, 4, // Min corner
-        1, 3, 1, 5,       // Adjacent min corner
-        2, 3, 2, 6,       // Top of the min face
-        3, 7,             // Remaining edge on the top face
-        4, 5, 4, 6,       // Max corner
-        5, 7, 6, 7        // Edges completing the cube
-    };
-
-    glColor3f(color.r, color.g, color.b);
-
-    glBegin(GL_LINES);
-    for (int i = 0; i < 24; ++i) 
-    {
-        const glm::vec3& vertex = vertices[indices[i]];
-        glVertex3f(vertex.x, vertex.y, vertex.z);
-    }
-    glEnd();
-}
-
-void Octree::Draw(const glm::vec3& color) const
-{
-    DrawNode(root.get(), color);
+    CollectBounds(root.get(), bounds);
 }
 
-void Octree::DrawNode(const OctreeNode* node, const glm::vec3& color) const
+void Octree::CollectBounds(const OctreeNode* node, std::vector<AABB>& bounds) const
 {
     if (!node) return;
 
-    DrawAABB(node->bounds, color);
+    bounds.push_back(node->bounds);
 
     for (const auto& child : node->children)
     {
         if (child)
         {
-            DrawNode(child.get(), color);
+            CollectBounds(child.get(), bounds);
         }
     }
 }
 
+void Octree::AddBounds(DebugDrawList& list, const std::vector<AABB>& bounds, const glm::vec3& color)
+{
+    for (const AABB& aabb : bounds)
+        list.AddAABB(aabb.min, aabb.max, glm::vec4(color, 1.0f));
+}
+
 void Octree::DrawView(ImDrawList* drawList, const ImVec2& windowSize, const ImVec2& windowPos, int type) const
 {
     if (!root) return;
@@ -5,6 +5,7 @@
 
 #include <vector>
 #include <memory>
+#include <unordered_map>
 
 #include "imgui.h"
 
@@ -14,8 +15,6 @@ struct OctreeNode
     std::vector<GameObject*> objects;
     std::array<std::unique_ptr<OctreeNode>, 8> children;
 
-    bool isOnFrustum = false;
-
     OctreeNode(const AABB& bounds) : bounds(bounds), children({ nullptr }) {}
 
     bool IsLeaf() const
@@ -27,7 +26,7 @@ struct OctreeNode
         return true;
     }
 
-    void UpdateIsOnFrustum(ComponentCamera* camera);
+    void UpdateIsOnFrustum(ComponentCamera* camera) const;
 };
 
 class Octree
@@ -37,7 +36,9 @@ public:
 	~Octree();
 
     void Insert(GameObject* object, const AABB& objectBounds);
-    void Draw(const glm::vec3& color = glm::vec3(1.0f, 1.0f , 0.0f)) const;
+    void Remove(const GameObject* object);
+    void CollectBounds(std::vector<AABB>& bounds) const;
+    static void AddBounds(DebugDrawList& list, const std::vector<AABB>& bounds, const glm::vec3& color = glm::vec3(1.0f, 1.0f, 0.0f));
     void DrawView(ImDrawList* drawList, const ImVec2& windowSize, const ImVec2& windowPos, int type) const;
     void UpdateAllNodesVisibility(ComponentCamera* camera) const;
     void Clear();
@@ -54,12 +55,15 @@ private:
 	void ClearNode(OctreeNode* node);
 	void CollectIntersectingObjects(const OctreeNode* node, const glm::vec3& rayOrigin, const glm::vec3& rayDirection, std::vector<GameObject*>& objects) const;
 
-    void DrawNode(const OctreeNode* node, const glm::vec3& color) const;
-    void DrawAABB(const AABB& aabb, const glm::vec3& color) const;
+    void CollectBounds(const OctreeNode* node, std::vector<AABB>& bounds) const;
     void DrawNodeView(const OctreeNode* node, ImDrawList* drawList, float scale, const ImVec2& windowSize, const glm::vec3& origin, const ImVec2& windowPos, const glm::vec2& translation, int type, uint depth) const;
 
 private:
     std::unique_ptr<OctreeNode> root;
     uint maxDepth;
     uint maxObjects;
+
+    // Leaves holding each object, so removal only touches those. Keys may be destroyed
+    // objects, they are never dereferenced.
+    std::unordered_map<const GameObject*, std::vector<OctreeNode*>> objectNodes;
 };
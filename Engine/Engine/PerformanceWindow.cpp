@@ -113,6 +113,39 @@ void PerformanceWindow::DrawWindow()
 		ImGui::TreePop();
 	}
 
+	if (ImGui::TreeNodeEx("JOBS", ImGuiTreeNodeFlags_DefaultOpen))
+	{
+		ImGui::SeparatorText("Information");
+
+		ImGui::Text("Worker Threads:");
+		ImGui::SameLine();
+		ImGui::TextColored(dataTextColor, "%d", app->jobs.GetWorkerCount());
+
+		for (int i = 0; i < app->jobs.GetWorkerCount(); ++i)
+		{
+			char workerOverlay[32];
+			sprintf_s(workerOverlay, "%.1f%% (%llu jobs)", app->jobs.GetWorkerUtilization(i) * 100.0f, app->jobs.GetWorkerJobCount(i));
+
+			ImGui::Text("Worker %2d", i);
+			ImGui::SameLine();
+			ImGui::ProgressBar(app->jobs.GetWorkerUtilization(i), ImVec2(ImGui::GetContentRegionAvail().x - 20, 0.0f), workerOverlay);
+		}
+
+		if (selectedWorkerCount == 0)
+			selectedWorkerCount = app->jobs.GetWorkerCount();
+
+		ImGui::SetNextItemWidth(100);
+		ImGui::SliderInt("##WorkerCount", &selectedWorkerCount, 1, static_cast<int>(sysInfo.dwNumberOfProcessors));
+		ImGui::SameLine();
+		if (ImGui::Button("Apply Workers") && selectedWorkerCount != app->jobs.GetWorkerCount())
+		{
+			// Submitters may still be running mid-frame, the app resizes between frames
+			app->RequestWorkerCount(selectedWorkerCount);
+		}
+
+		ImGui::TreePop();
+	}
+
 	if (ImGui::TreeNodeEx("MEMORY", ImGuiTreeNodeFlags_DefaultOpen))
 	{
 		ImGui::SeparatorText("Information");
@@ -218,6 +251,29 @@ void PerformanceWindow::DrawWindow()
 		ImGui::SameLine();
 		ImGui::TextColored(dataTextColor, "%d", static_cast<int>(maxFps));
 
+		ImGui::Text("Frame Time:");
+		ImGui::SameLine();
+		ImGui::TextColored(dataTextColor, "%.2f ms (avg %.2f ms)", app->pacer.GetLastFrameMs(), app->pacer.GetAverageFrameMs());
+
+		ImGui::Text("Frame Time Std Dev:");
+		ImGui::SameLine();
+		ImGui::TextColored(dataTextColor, "%.3f ms", app->pacer.GetFrameTimeStdDevMs());
+
+		ImGui::Text("Max Deviation:");
+		ImGui::SameLine();
+		ImGui::TextColored(dataTextColor, "%.3f ms", app->pacer.GetMaxDeviationMs());
+
+		if (app->renderer3D->threadedRendering)
+		{
+			ImGui::Text("Render Thread:");
+			ImGui::SameLine();
+			ImGui::TextColored(dataTextColor, "%.2f ms", app->renderer3D->renderThreadMs);
+
+			ImGui::Text("Waiting for Render:");
+			ImGui::SameLine();
+			ImGui::TextColored(dataTextColor, "%.2f ms", app->renderer3D->renderWaitMs);
+		}
+
 		char fpsOverlay[32];
 		sprintf_s(fpsOverlay, "%d FPS", static_cast<int>(currentFps));
 		ImGui::PlotLines(
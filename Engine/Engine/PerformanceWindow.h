@@ -36,4 +36,7 @@ private:
 	float fpsHistory[FPS_HISTORY_SIZE] = {};
 	int fpsHistoryOffset = 0;
 	const char* fpsOptions[6] = { "30", "60", "90", "120", "144", "240" };
+
+	// Jobs
+	int selectedWorkerCount = 0;
 };
\ No newline at end of file
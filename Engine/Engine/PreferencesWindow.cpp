@@ -37,8 +37,11 @@ void PreferencesWindow::DrawWindow()
 	if (ImGui::CollapsingHeader("Render", ImGuiTreeNodeFlags_DefaultOpen))
 	{
 		ImGui::Checkbox("Show Textures", &drawTextures);
-		if (ImGui::Checkbox("Cull face", &cullFace))
-			cullFace ? glEnable(GL_CULL_FACE) : glDisable(GL_CULL_FACE);
+		ImGui::Checkbox("Cull face", &cullFace);
+		ImGui::Checkbox("Shaders", &shaders);
+		ImGui::Checkbox("Instancing", &instancing);
+		ImGui::Checkbox("Multi-Draw Indirect", &multiDraw);
+		ImGui::Checkbox("Static Batching", &app->renderer3D->staticBatcher.enabled);
 
 		ImGui::Spacing();
 		ImGui::Separator();
@@ -55,6 +58,21 @@ void PreferencesWindow::DrawWindow()
 		ImGui::ColorEdit3("Face Color", (float*)&faceNormalColor, ImGuiColorEditFlags_NoInputs | ImGuiColorEditFlags_NoLabel);
 		ImGui::SameLine();
 		ImGui::Text("Face Normal Color");
+
+		ImGui::Spacing();
+		ImGui::Separator();
+
+		ImGui::Checkbox("Throttle When Idle", &app->idleThrottling);
+
+		ImGui::BeginDisabled(!app->idleThrottling);
+		ImGui::PushItemWidth(200.f);
+		ImGui::SliderInt("Idle Refresh Rate", &app->idleRefreshRate, 1, 30, "%d Hz");
+		ImGui::PopItemWidth();
+		ImGui::EndDisabled();
+
+		ImGui::PushItemWidth(200.f);
+		ImGui::SliderFloat("Background Budget", &app->tasks.frameBudgetMs, 0.5f, 16.0f, "%.1f ms");
+		ImGui::PopItemWidth();
 	}
 
 	if (ImGui::CollapsingHeader("Grid", ImGuiTreeNodeFlags_DefaultOpen))
@@ -102,6 +120,18 @@ void PreferencesWindow::DrawWindow()
 		}
 	}
 
+	if (ImGui::CollapsingHeader("Time", ImGuiTreeNodeFlags_DefaultOpen))
+	{
+		ImGui::Checkbox("Fixed Timestep", &app->time.fixedStep);
+
+		ImGui::BeginDisabled(!app->time.fixedStep);
+		ImGui::PushItemWidth(200.f);
+		ImGui::SliderFloat("Tick Rate", &app->time.tickRate, 10.0f, 240.0f, "%.0f Hz");
+		ImGui::SliderInt("Max Catch-up Steps", &app->time.maxFixedSteps, 1, 20);
+		ImGui::PopItemWidth();
+		ImGui::EndDisabled();
+	}
+
 	if (ImGui::CollapsingHeader("Camera", ImGuiTreeNodeFlags_DefaultOpen))
 	{
 		ImGui::Text("Fov ");
@@ -17,6 +17,9 @@ public:
 	bool wireframe = false;
 	bool shadedWireframe = false;
 	bool cullFace = true;
+	bool shaders = true;
+	bool instancing = true;
+	bool multiDraw = true;
 
 	// Normals settings
 	float vertexNormalLength = 0.1f;
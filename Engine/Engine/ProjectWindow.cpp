@@ -1,6 +1,47 @@
 #include "ProjectWindow.h"
 #include "App.h"
 
+class DirectoryScanTask : public BackgroundTask
+{
+public:
+	DirectoryScanTask(const std::filesystem::path& path, bool showEngineContent, uint32_t generation, uint32_t& latestGeneration, std::vector<std::filesystem::directory_entry>& target)
+		: BackgroundTask("Scanning " + path.string(), TaskMode::WORKER), path(path), showEngineContent(showEngineContent),
+		generation(generation), latestGeneration(latestGeneration), target(target) {}
+
+	bool Step(int64_t deadlineNs) override
+	{
+		const bool isRootDir = (path == ".");
+
+		std::error_code error;
+		for (const auto& entry : std::filesystem::directory_iterator(path, error))
+		{
+			if (!isRootDir || (entry.is_directory() && (entry.path().filename() == "Assets" || (entry.path().filename() == "Engine" && showEngineContent))))
+			{
+				contents.push_back(entry);
+			}
+		}
+
+		if (error)
+			LOG(LogType::LOG_WARNING, "Could not read directory %s", path.string().c_str());
+
+		return true;
+	}
+
+	void Complete() override
+	{
+		if (generation == latestGeneration)
+			target.swap(contents);
+	}
+
+private:
+	std::filesystem::path path;
+	bool showEngineContent = false;
+	uint32_t generation = 0;
+	uint32_t& latestGeneration;
+	std::vector<std::filesystem::directory_entry>& target;
+	std::vector<std::filesystem::directory_entry> contents;
+};
+
 ProjectWindow::ProjectWindow(const WindowType type, const std::string& name) : EditorWindow(type, name), currentPath(".")
 {
 	UpdateDirectoryContent();
@@ -57,17 +98,8 @@ void ProjectWindow::SetupInitialColumnWidth()
 
 void ProjectWindow::UpdateDirectoryContent()
 {
-	directoryContents.clear();
-
-	bool isRootDir = (currentPath == ".");
-
-	for (const auto& entry : std::filesystem::directory_iterator(currentPath))
-	{
-		if (!isRootDir || (entry.is_directory() && (entry.path().filename() == "Assets" || (entry.path().filename() == "Engine" && showEngineContent))))
-		{
-			directoryContents.push_back(entry);
-		}
-	}
+	scanGeneration++;
+	app->tasks.Add(new DirectoryScanTask(currentPath, showEngineContent, scanGeneration, scanGeneration, directoryContents));
 }
 
 std::vector<std::string> ProjectWindow::GetPathParts() const
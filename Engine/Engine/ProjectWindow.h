@@ -2,6 +2,7 @@
 
 #include "EditorWindow.h"
 
+#include <cstdint>
 #include <filesystem>
 #include <vector>
 #include <string>
@@ -60,6 +61,9 @@ private:
 	std::filesystem::path selectedPath;
 	std::vector<std::filesystem::directory_entry> directoryContents;
 
+	// Scans run on a worker, only the results of the latest one are kept
+	uint32_t scanGeneration = 0;
+
 	bool showPathBar = false;
 
 	bool isItemSelected = false;
@@ -0,0 +1,54 @@
+#include "RadixSort.h"
+
+#include <cstring>
+
+void RadixSort(std::vector<SortEntry>& entries, std::vector<SortEntry>& scratch)
+{
+	const size_t count = entries.size();
+	if (count < 2)
+		return;
+
+	// Histograms of every byte in a single read of the keys
+	uint32_t histograms[8][256];
+	memset(histograms, 0, sizeof(histograms));
+
+	for (const SortEntry& entry : entries)
+	{
+		for (int pass = 0; pass < 8; ++pass)
+			++histograms[pass][(entry.key >> (pass * 8)) & 0xFF];
+	}
+
+	scratch.resize(count);
+	SortEntry* source = entries.data();
+	SortEntry* destination = scratch.data();
+
+	for (int pass = 0; pass < 8; ++pass)
+	{
+		uint32_t* histogram = histograms[pass];
+
+		const uint32_t firstByte = static_cast<uint32_t>((source[0].key >> (pass * 8)) & 0xFF);
+		if (histogram[firstByte] == count)
+			continue;
+
+		uint32_t offset = 0;
+		for (int i = 0; i < 256; ++i)
+		{
+			const uint32_t bucket = histogram[i];
+			histogram[i] = offset;
+			offset += bucket;
+		}
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			const uint32_t byte = static_cast<uint32_t>((source[i].key >> (pass * 8)) & 0xFF);
+			destination[histogram[byte]++] = source[i];
+		}
+
+		SortEntry* swap = source;
+		source = destination;
+		destination = swap;
+	}
+
+	if (source != entries.data())
+		memcpy(entries.data(), source, count * sizeof(SortEntry));
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+struct SortEntry
+{
+	uint64_t key;
+	uint32_t index;
+};
+
+// Stable LSD radix sort on the 64-bit keys, one byte per pass. Bytes that are the
+// same in every key are skipped, so short keys or mostly equal keys sort in a few passes.
+void RadixSort(std::vector<SortEntry>& entries, std::vector<SortEntry>& scratch);
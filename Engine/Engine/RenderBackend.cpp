@@ -0,0 +1,60 @@
+#include "RenderBackend.h"
+#include "Mesh.h"
+
+#include <cstdio>
+
+void NullRenderBackend::Execute(const RenderCommandBuffer& commands, const RenderSnapshot& snapshot)
+{
+	commandCount += static_cast<uint32_t>(commands.commands.size());
+
+	for (const RenderCommand& command : commands.commands)
+	{
+		if (command.type == RenderCommandType::DRAW_ELEMENTS)
+		{
+			stats.draws++;
+			stats.submittedDraws += command.count;
+		}
+		else if (command.type == RenderCommandType::DRAW_RANGES)
+		{
+			stats.draws++;
+			stats.submittedDraws++;
+		}
+		else if (command.type == RenderCommandType::MULTI_DRAW_INDIRECT)
+		{
+			stats.draws++;
+			stats.submittedDraws += command.draws;
+		}
+		else if (command.type == RenderCommandType::BIND_TEXTURE)
+		{
+			stats.textureBinds++;
+		}
+	}
+}
+
+void RecordingRenderBackend::Execute(const RenderCommandBuffer& commands, const RenderSnapshot& snapshot)
+{
+	this->commands.insert(this->commands.end(), commands.commands.begin(), commands.commands.end());
+}
+
+std::string RecordingRenderBackend::Dump() const
+{
+	std::string output;
+	char line[256];
+
+	for (const RenderCommand& command : commands)
+	{
+		int length = snprintf(line, sizeof(line), "%s value=%u count=%u draws=%u flag=%d",
+			RenderCommandBuffer::GetTypeName(command.type), command.value, command.count, command.draws, command.flag ? 1 : 0);
+
+		if (command.mesh != nullptr && length > 0 && length < static_cast<int>(sizeof(line)))
+		{
+			snprintf(line + length, sizeof(line) - length, " mesh=%u/%u",
+				command.mesh->verticesCount, command.mesh->indicesCount);
+		}
+
+		output += line;
+		output += '\n';
+	}
+
+	return output;
+}
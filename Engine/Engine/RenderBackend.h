@@ -0,0 +1,46 @@
+#pragma once
+
+#include "RenderCommands.h"
+#include "RenderState.h"
+
+#include <string>
+#include <vector>
+
+struct RenderSnapshot;
+
+// Replays the commands recorded for one view. The snapshot is only read for the
+// settings shared by every view (grid, octree bounds, normal lengths...).
+class RenderBackend
+{
+public:
+	virtual ~RenderBackend() {}
+
+	virtual void Execute(const RenderCommandBuffer& commands, const RenderSnapshot& snapshot) = 0;
+};
+
+// Drops every command, only counts the draws they would have issued
+class NullRenderBackend : public RenderBackend
+{
+public:
+	void Execute(const RenderCommandBuffer& commands, const RenderSnapshot& snapshot) override;
+
+public:
+	RenderStats stats;
+	uint32_t commandCount = 0;
+};
+
+// Keeps a copy of every command it is given, for inspecting the stream without a context
+class RecordingRenderBackend : public RenderBackend
+{
+public:
+	void Execute(const RenderCommandBuffer& commands, const RenderSnapshot& snapshot) override;
+
+	void Clear() { commands.clear(); }
+
+	// One line per command, meshes are written as their vertex and index counts so the
+	// output does not depend on addresses
+	std::string Dump() const;
+
+public:
+	std::vector<RenderCommand> commands;
+};
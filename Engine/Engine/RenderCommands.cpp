@@ -0,0 +1,161 @@
+#include "RenderCommands.h"
+
+void RenderCommandBuffer::Clear()
+{
+	commands.clear();
+	matrices.clear();
+	instanceTransforms.clear();
+	indirectCommands.clear();
+	indexRanges.clear();
+	debug.Clear();
+}
+
+RenderCommand& RenderCommandBuffer::Push(RenderCommandType type)
+{
+	commands.emplace_back();
+	RenderCommand& command = commands.back();
+	command.type = type;
+	return command;
+}
+
+uint32_t RenderCommandBuffer::AddMatrix(const glm::mat4& matrix)
+{
+	matrices.push_back(matrix);
+	return static_cast<uint32_t>(matrices.size() - 1);
+}
+
+void RenderCommandBuffer::BeginView(int width, int height)
+{
+	RenderCommand& command = Push(RenderCommandType::BEGIN_VIEW);
+	command.value = static_cast<uint32_t>(width);
+	command.count = static_cast<uint32_t>(height);
+}
+
+void RenderCommandBuffer::SetCullFace(bool enabled)
+{
+	Push(RenderCommandType::SET_CULL_FACE).flag = enabled;
+}
+
+void RenderCommandBuffer::SetCamera(const glm::mat4& projection, const glm::mat4& view)
+{
+	const uint32_t projectionIndex = AddMatrix(projection);
+	const uint32_t viewIndex = AddMatrix(view);
+
+	RenderCommand& command = Push(RenderCommandType::SET_CAMERA);
+	command.value = projectionIndex;
+	command.count = viewIndex;
+}
+
+void RenderCommandBuffer::LoadModelView(const glm::mat4& modelView)
+{
+	const uint32_t index = AddMatrix(modelView);
+	Push(RenderCommandType::LOAD_MODELVIEW).value = index;
+}
+
+void RenderCommandBuffer::ResetState()
+{
+	Push(RenderCommandType::RESET_STATE);
+}
+
+void RenderCommandBuffer::UseFixedFunction()
+{
+	Push(RenderCommandType::USE_FIXED_FUNCTION);
+}
+
+void RenderCommandBuffer::UseShader(ShaderType shader)
+{
+	Push(RenderCommandType::USE_SHADER).value = static_cast<uint32_t>(shader);
+}
+
+void RenderCommandBuffer::BindTexture(GLuint texture)
+{
+	Push(RenderCommandType::BIND_TEXTURE).value = texture;
+}
+
+void RenderCommandBuffer::SetColor(const glm::vec3& color)
+{
+	Push(RenderCommandType::SET_COLOR).color = color;
+}
+
+void RenderCommandBuffer::SetPolygonMode(GLenum mode)
+{
+	Push(RenderCommandType::SET_POLYGON_MODE).value = mode;
+}
+
+void RenderCommandBuffer::BindGeometry(const GeometryPage* page)
+{
+	Push(RenderCommandType::BIND_GEOMETRY).page = page;
+}
+
+void RenderCommandBuffer::BeginInstances(uint32_t firstInstance)
+{
+	Push(RenderCommandType::BEGIN_INSTANCES).value = firstInstance;
+}
+
+void RenderCommandBuffer::EndInstances()
+{
+	Push(RenderCommandType::END_INSTANCES);
+}
+
+void RenderCommandBuffer::DrawElements(const Mesh* mesh, uint32_t lod, uint32_t instanceCount)
+{
+	RenderCommand& command = Push(RenderCommandType::DRAW_ELEMENTS);
+	command.mesh = mesh;
+	command.value = lod;
+	command.count = instanceCount;
+}
+
+void RenderCommandBuffer::DrawRanges(const Mesh* mesh, uint32_t firstRange, uint32_t rangeCount)
+{
+	RenderCommand& command = Push(RenderCommandType::DRAW_RANGES);
+	command.mesh = mesh;
+	command.value = firstRange;
+	command.count = rangeCount;
+}
+
+void RenderCommandBuffer::MultiDrawIndirect(uint32_t firstCommand, uint32_t commandCount, uint32_t drawCount)
+{
+	RenderCommand& command = Push(RenderCommandType::MULTI_DRAW_INDIRECT);
+	command.value = firstCommand;
+	command.count = commandCount;
+	command.draws = drawCount;
+}
+
+void RenderCommandBuffer::DrawOutline(const Mesh* mesh, bool parentSelected)
+{
+	RenderCommand& command = Push(RenderCommandType::DRAW_OUTLINE);
+	command.mesh = mesh;
+	command.flag = parentSelected;
+}
+
+void RenderCommandBuffer::DrawDebug(bool shared)
+{
+	Push(RenderCommandType::DRAW_DEBUG).flag = shared;
+}
+
+const char* RenderCommandBuffer::GetTypeName(RenderCommandType type)
+{
+	switch (type)
+	{
+	case RenderCommandType::BEGIN_VIEW: return "BeginView";
+	case RenderCommandType::SET_CULL_FACE: return "SetCullFace";
+	case RenderCommandType::SET_CAMERA: return "SetCamera";
+	case RenderCommandType::LOAD_MODELVIEW: return "LoadModelView";
+	case RenderCommandType::RESET_STATE: return "ResetState";
+	case RenderCommandType::USE_FIXED_FUNCTION: return "UseFixedFunction";
+	case RenderCommandType::USE_SHADER: return "UseShader";
+	case RenderCommandType::BIND_TEXTURE: return "BindTexture";
+	case RenderCommandType::SET_COLOR: return "SetColor";
+	case RenderCommandType::SET_POLYGON_MODE: return "SetPolygonMode";
+	case RenderCommandType::BIND_GEOMETRY: return "BindGeometry";
+	case RenderCommandType::BEGIN_INSTANCES: return "BeginInstances";
+	case RenderCommandType::END_INSTANCES: return "EndInstances";
+	case RenderCommandType::DRAW_ELEMENTS: return "DrawElements";
+	case RenderCommandType::DRAW_RANGES: return "DrawRanges";
+	case RenderCommandType::MULTI_DRAW_INDIRECT: return "MultiDrawIndirect";
+	case RenderCommandType::DRAW_OUTLINE: return "DrawOutline";
+	case RenderCommandType::DRAW_DEBUG: return "DrawDebug";
+	}
+
+	return "Unknown";
+}
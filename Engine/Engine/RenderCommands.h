@@ -0,0 +1,94 @@
+#pragma once
+
+#include "DebugDraw.h"
+#include "GeometryPool.h"
+#include "ShaderCache.h"
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+class Mesh;
+
+enum class RenderCommandType : uint8_t
+{
+	BEGIN_VIEW,				// value: width, count: height. Binds and clears the view target
+	SET_CULL_FACE,			// flag
+	SET_CAMERA,				// value: projection matrix index, count: view matrix index. Leaves the view in the modelview
+	LOAD_MODELVIEW,			// value: matrix index
+	RESET_STATE,			// Forget cached state, something drew behind the backend's back
+	USE_FIXED_FUNCTION,
+	USE_SHADER,				// value: ShaderType
+	BIND_TEXTURE,			// value: texture id
+	SET_COLOR,				// color
+	SET_POLYGON_MODE,		// value: GL_FILL or GL_LINE
+	BIND_GEOMETRY,			// page, 0 unbinds
+	BEGIN_INSTANCES,		// value: first per-draw transform
+	END_INSTANCES,
+	DRAW_ELEMENTS,			// mesh, value: LOD, count: instances
+	DRAW_RANGES,			// mesh, value: first index range, count: ranges
+	MULTI_DRAW_INDIRECT,	// value: first indirect command, count: commands, draws: meshes drawn
+	DRAW_OUTLINE,			// mesh, flag: parent selected
+	DRAW_DEBUG				// flag: the snapshot debug list instead of the view one
+};
+
+struct RenderCommand
+{
+	RenderCommandType type;
+	bool flag = false;
+	uint32_t value = 0;
+	uint32_t count = 0;
+	uint32_t draws = 0;
+	const Mesh* mesh = nullptr;
+	const GeometryPage* page = nullptr;
+	glm::vec3 color = glm::vec3(1.0f);
+};
+
+// Everything needed to draw one view, recorded without touching GL so any thread can
+// build it. Backends replay it, the GL one on the thread that owns the context.
+class RenderCommandBuffer
+{
+public:
+	void Clear();
+
+	void BeginView(int width, int height);
+	void SetCullFace(bool enabled);
+	void SetCamera(const glm::mat4& projection, const glm::mat4& view);
+	void LoadModelView(const glm::mat4& modelView);
+	void ResetState();
+	void UseFixedFunction();
+	void UseShader(ShaderType shader);
+	void BindTexture(GLuint texture);
+	void SetColor(const glm::vec3& color);
+	void SetPolygonMode(GLenum mode);
+	void BindGeometry(const GeometryPage* page);
+	void BeginInstances(uint32_t firstInstance);
+	void EndInstances();
+	void DrawElements(const Mesh* mesh, uint32_t lod, uint32_t instanceCount = 1);
+	void DrawRanges(const Mesh* mesh, uint32_t firstRange, uint32_t rangeCount);
+	void MultiDrawIndirect(uint32_t firstCommand, uint32_t commandCount, uint32_t drawCount);
+	void DrawOutline(const Mesh* mesh, bool parentSelected);
+	void DrawDebug(bool shared);
+
+	uint32_t AddMatrix(const glm::mat4& matrix);
+
+	static const char* GetTypeName(RenderCommandType type);
+
+public:
+	std::vector<RenderCommand> commands;
+	std::vector<glm::mat4> matrices;
+
+	// Per-draw world matrices and indirect commands, uploaded when the view begins
+	std::vector<glm::mat4> instanceTransforms;
+	std::vector<DrawElementsIndirectCommand> indirectCommands;
+
+	// Full level index ranges of the meshes drawn in parts, filled while culling
+	std::vector<IndexRange> indexRanges;
+
+	// Grid, octree, normals and bounds of this view, drawn by DrawDebug
+	DebugDrawList debug;
+
+private:
+	RenderCommand& Push(RenderCommandType type);
+};
@@ -0,0 +1,254 @@
+#include "RenderSnapshot.h"
+
+void RenderView::Sort()
+{
+	sortEntries.resize(items.size());
+	for (size_t i = 0; i < items.size(); ++i)
+		sortEntries[i] = { items[i].sortKey, static_cast<uint32_t>(i) };
+
+	RadixSort(sortEntries, sortScratch);
+
+	drawOrder.resize(sortEntries.size());
+	for (size_t i = 0; i < sortEntries.size(); ++i)
+		drawOrder[i] = sortEntries[i].index;
+}
+
+void RenderView::BuildBatches(uint32_t minInstances)
+{
+	batches.clear();
+	drawBuckets.clear();
+
+	std::vector<glm::mat4>& instanceTransforms = commands.instanceTransforms;
+	std::vector<DrawElementsIndirectCommand>& drawCommands = commands.indirectCommands;
+
+	const uint32_t count = static_cast<uint32_t>(drawOrder.size());
+	for (uint32_t first = 0; first < count;)
+	{
+		const RenderItem& item = items[drawOrder[first]];
+
+		uint32_t last = first + 1;
+		if (!item.IsDrawnAlone())
+		{
+			while (last < count)
+			{
+				const RenderItem& next = items[drawOrder[last]];
+				if (next.mesh != item.mesh || next.lod != item.lod || next.textureId != item.textureId || next.IsDrawnAlone())
+					break;
+				++last;
+			}
+		}
+
+		RenderBatch batch;
+		batch.first = first;
+		batch.count = last - first;
+		batch.single = item.IsDrawnAlone();
+		batch.instanced = !batch.single && batch.count >= minInstances && item.mesh->HasGeometry();
+
+		if (item.mesh->HasGeometry())
+		{
+			// Shaders read the world matrix of every draw from here, items drawn alone included
+			batch.instanceOffset = static_cast<uint32_t>(instanceTransforms.size());
+			for (uint32_t i = first; i < last; ++i)
+				instanceTransforms.push_back(items[drawOrder[i]].transform);
+		}
+
+		if (!batch.single && item.mesh->HasGeometry())
+		{
+			const GeometryAllocation geometry = item.mesh->GetLodGeometry(item.lod);
+			const glm::vec3 color = glm::vec3(item.mesh->diffuseColor);
+
+			DrawElementsIndirectCommand command;
+			command.count = geometry.indexCount;
+			command.instanceCount = batch.count;
+			command.firstIndex = geometry.firstIndex;
+			command.baseVertex = static_cast<int32_t>(geometry.baseVertex);
+			command.baseInstance = batch.instanceOffset;
+
+			if (drawBuckets.empty() || drawBuckets.back().page != geometry.page || drawBuckets.back().textureId != item.textureId || drawBuckets.back().color != color)
+			{
+				DrawBucket bucket;
+				bucket.page = geometry.page;
+				bucket.textureId = item.textureId;
+				bucket.color = color;
+				bucket.firstCommand = static_cast<uint32_t>(drawCommands.size());
+				drawBuckets.push_back(bucket);
+			}
+
+			drawCommands.push_back(command);
+			drawBuckets.back().commandCount++;
+			drawBuckets.back().drawCount += batch.count;
+		}
+
+		batches.push_back(batch);
+		first = last;
+	}
+}
+
+void RenderView::Record(const RenderSnapshot& settings)
+{
+	commands.BeginView(width, height);
+	commands.SetCullFace(settings.cullFace);
+	commands.SetCamera(projection, view);
+
+	// The editor touches the same state behind the cache's back
+	commands.ResetState();
+
+	if (settings.multiDraw)
+	{
+		// Every batch goes through the buckets, except items drawn alone which come after
+		for (const DrawBucket& bucket : drawBuckets)
+			RecordBucket(bucket, settings);
+
+		for (const RenderBatch& batch : batches)
+		{
+			if (batch.single)
+				RecordItem(items[drawOrder[batch.first]], batch.instanceOffset, settings);
+		}
+	}
+	else
+	{
+		for (const RenderBatch& batch : batches)
+		{
+			if (batch.instanced && settings.instancing)
+			{
+				RecordInstances(batch, settings);
+				continue;
+			}
+
+			for (uint32_t i = 0; i < batch.count; ++i)
+				RecordItem(items[drawOrder[batch.first + i]], batch.instanceOffset + i, settings);
+		}
+	}
+
+	commands.UseFixedFunction();
+	commands.BindGeometry(nullptr);
+	commands.BindTexture(0);
+	commands.SetPolygonMode(GL_FILL);
+	commands.SetColor(glm::vec3(1.0f));
+
+	// Every debug line of the view in one upload, after the meshes they are depth tested against.
+	// The view's own list holds what comes from its culled items (normals, bounding boxes),
+	// recorded by the view jobs in parallel without sharing the module's lock.
+	commands.LoadModelView(view);
+	if (!commands.debug.IsEmpty())
+		commands.DrawDebug(false);
+	if (editorView && !settings.debugDraw.IsEmpty())
+		commands.DrawDebug(true);
+}
+
+void RenderView::RecordMesh(const RenderItem& item, const RenderSnapshot& settings, uint32_t instanceCount)
+{
+	const Mesh* mesh = item.mesh;
+	if (!mesh->HasGeometry())
+		return;
+
+	const bool wireframe = editorView && settings.wireframe;
+	const bool shadedWireframe = editorView && settings.shadedWireframe;
+
+	const GLuint texture = settings.drawTextures && !wireframe ? item.textureId : 0;
+
+	if (settings.shaders)
+		commands.UseShader(texture != 0 ? ShaderType::TEXTURED : ShaderType::UNLIT);
+	commands.SetPolygonMode(wireframe && !shadedWireframe ? GL_LINE : GL_FILL);
+	commands.SetColor(glm::vec3(mesh->diffuseColor));
+	commands.BindTexture(texture);
+	commands.BindGeometry(mesh->geometry.page);
+	RecordDraw(item, instanceCount);
+
+	if (shadedWireframe)
+	{
+		if (settings.shaders)
+			commands.UseShader(ShaderType::WIREFRAME);
+		commands.SetPolygonMode(GL_LINE);
+		commands.BindTexture(0);
+		commands.SetColor(glm::vec3(0.0f, 1.0f, 0.0f));
+		RecordDraw(item, instanceCount);
+	}
+}
+
+void RenderView::RecordDraw(const RenderItem& item, uint32_t instanceCount)
+{
+	if (item.rangeCount > 0)
+		commands.DrawRanges(item.mesh, item.firstRange, item.rangeCount);
+	else
+		commands.DrawElements(item.mesh, item.lod, instanceCount);
+}
+
+void RenderView::RecordItem(const RenderItem& item, uint32_t drawIndex, const RenderSnapshot& settings)
+{
+	if (!item.decorationsOnly && settings.shaders && item.mesh->HasGeometry())
+	{
+		// One instance reading its world matrix from the per-draw transforms
+		commands.BindGeometry(item.mesh->geometry.page);
+		commands.BeginInstances(drawIndex);
+		RecordMesh(item, settings, 1);
+		commands.EndInstances();
+	}
+
+	if (item.vertexNormals || item.faceNormals)
+	{
+		item.mesh->AddNormals(commands.debug, item.transform, item.vertexNormals, item.faceNormals,
+			settings.vertexNormalLength, settings.faceNormalLength, settings.vertexNormalColor, settings.faceNormalColor);
+	}
+
+	if (item.drawAABB)
+		item.mesh->AddAABB(commands.debug, item.transform);
+	if (item.drawOBB)
+		item.mesh->AddOBB(commands.debug, item.transform);
+
+	const bool drawOutline = item.drawOutline && item.mesh->HasGeometry();
+	if (!drawOutline && (settings.shaders || item.decorationsOnly))
+		return;
+
+	// The outline, and everything without shaders, go through the matrix stack
+	commands.UseFixedFunction();
+	commands.LoadModelView(view * item.transform);
+
+	if (!item.decorationsOnly && !settings.shaders)
+		RecordMesh(item, settings, 1);
+
+	if (drawOutline)
+		commands.DrawOutline(item.mesh, item.parentSelected);
+}
+
+void RenderView::RecordInstances(const RenderBatch& batch, const RenderSnapshot& settings)
+{
+	const RenderItem& item = items[drawOrder[batch.first]];
+
+	// The camera comes from its uniform buffer, the world matrices from the instances
+	commands.BindGeometry(item.mesh->geometry.page);
+	commands.BeginInstances(batch.instanceOffset);
+
+	RecordMesh(item, settings, batch.count);
+
+	commands.EndInstances();
+}
+
+void RenderView::RecordBucket(const DrawBucket& bucket, const RenderSnapshot& settings)
+{
+	const bool wireframe = editorView && settings.wireframe;
+	const bool shadedWireframe = editorView && settings.shadedWireframe;
+
+	const GLuint texture = settings.drawTextures && !wireframe ? bucket.textureId : 0;
+
+	// baseInstance of each command indexes the transforms of this view
+	commands.BindGeometry(bucket.page);
+	commands.BeginInstances(0);
+
+	commands.UseShader(texture != 0 ? ShaderType::TEXTURED : ShaderType::UNLIT);
+	commands.SetPolygonMode(wireframe && !shadedWireframe ? GL_LINE : GL_FILL);
+	commands.SetColor(bucket.color);
+	commands.BindTexture(texture);
+	commands.MultiDrawIndirect(bucket.firstCommand, bucket.commandCount, bucket.drawCount);
+
+	if (shadedWireframe)
+	{
+		commands.UseShader(ShaderType::WIREFRAME);
+		commands.SetPolygonMode(GL_LINE);
+		commands.BindTexture(0);
+		commands.SetColor(glm::vec3(0.0f, 1.0f, 0.0f));
+		commands.MultiDrawIndirect(bucket.firstCommand, bucket.commandCount, bucket.drawCount);
+	}
+
+	commands.EndInstances();
+}
@@ -0,0 +1,189 @@
+#pragma once
+
+#include "Mesh.h"
+#include "RadixSort.h"
+#include "RenderCommands.h"
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// Items are drawn in pass order, outlined items last since they overwrite the stencil
+enum class RenderPass : uint8_t
+{
+	GEOMETRY = 0,
+	OUTLINED = 1
+};
+
+// pass (8 bits) | texture (16 bits) | mesh and LOD (16 bits) | depth (24 bits). Sorting by
+// the key groups draws sharing a texture and then a mesh level, front to back inside each
+// group. Texture and mesh bits may collide, which only costs a redundant bind.
+inline uint64_t MakeSortKey(RenderPass pass, GLuint texture, const Mesh* mesh, uint lod, float depth)
+{
+	// Non-negative floats order the same as their bits
+	depth = depth > 0.0f ? depth : 0.0f;
+	uint32_t depthBits;
+	memcpy(&depthBits, &depth, sizeof(depthBits));
+
+	const uint64_t meshBits = (((reinterpret_cast<uintptr_t>(mesh) >> 4) << 2) | (lod & 0x3)) & 0xFFFF;
+
+	return (static_cast<uint64_t>(pass) << 56)
+		| (static_cast<uint64_t>(texture & 0xFFFF) << 40)
+		| (meshBits << 24)
+		| (depthBits >> 8);
+}
+
+// Everything the render thread needs to draw one mesh. Copied by value so the
+// simulation can keep changing (or destroying) the GameObject while it is drawn.
+struct RenderItem
+{
+	const Mesh* mesh = nullptr;
+	uint lod = 0;
+	GLuint textureId = 0;
+	glm::mat4 transform = glm::mat4(1.0f);
+	uint64_t sortKey = 0;
+
+	bool drawOutline = false;
+	bool parentSelected = false;
+	bool vertexNormals = false;
+	bool faceNormals = false;
+	bool drawAABB = false;
+	bool drawOBB = false;
+
+	// Visible meshlets of a partly culled mesh, as ranges in the view index ranges
+	uint32_t firstRange = 0;
+	uint32_t rangeCount = 0;
+
+	// Static batched objects only draw their editor decorations, a cluster draws the mesh
+	bool decorationsOnly = false;
+
+	bool HasDecorations() const { return drawOutline || vertexNormals || faceNormals || drawAABB || drawOBB; }
+
+	// Items with editor decorations or culled meshlets are always drawn on their own
+	bool IsDrawnAlone() const { return HasDecorations() || rangeCount > 0; }
+};
+
+// A run of drawOrder sharing mesh, LOD and texture. Batches with geometry keep their
+// world matrices from instanceOffset in the instance transforms of the view commands.
+struct RenderBatch
+{
+	uint32_t first = 0;
+	uint32_t count = 0;
+	uint32_t instanceOffset = 0;
+	bool instanced = false;
+	bool single = false;	// One item drawn alone, see RenderItem::IsDrawnAlone
+};
+
+// Consecutive indirect commands drawn with the same page, texture and color
+struct DrawBucket
+{
+	const GeometryPage* page = nullptr;
+	GLuint textureId = 0;
+	glm::vec3 color = glm::vec3(1.0f);
+	uint32_t firstCommand = 0;
+	uint32_t commandCount = 0;
+	uint32_t drawCount = 0;
+};
+
+struct RenderSnapshot;
+
+struct RenderView
+{
+	bool enabled = false;
+	bool editorView = false;
+
+	glm::mat4 projection = glm::mat4(1.0f);
+	glm::mat4 view = glm::mat4(1.0f);
+	glm::vec3 cameraPosition = glm::vec3(0.0f);
+
+	// Meshlets facing away are only culled when back faces are
+	bool cullBackfaces = true;
+
+	int width = 0;
+	int height = 0;
+
+	std::vector<RenderItem> items;
+
+	// Indices into items sorted by their keys, drawn in this order
+	std::vector<uint32_t> drawOrder;
+	std::vector<SortEntry> sortEntries;
+	std::vector<SortEntry> sortScratch;
+
+	std::vector<RenderBatch> batches;
+
+	// Scratch of the meshlet culling of one mesh
+	std::vector<uint8_t> meshletVisibility;
+
+	// Every batch not drawn alone is also one indirect command in the view commands
+	std::vector<DrawBucket> drawBuckets;
+
+	// What the backend replays to draw this view. The index ranges are written while
+	// culling, everything else once the items are sorted.
+	RenderCommandBuffer commands;
+
+	void Sort();
+
+	// Sorted items sharing mesh, LOD and texture are next to each other, each run of them
+	// becomes one batch. Runs of at least minInstances are drawn instanced.
+	void BuildBatches(uint32_t minInstances);
+
+	// Records the batches into commands. Only reads the view and the snapshot
+	// settings, so each view can be recorded by its own culling job.
+	void Record(const RenderSnapshot& settings);
+
+	void Clear()
+	{
+		items.clear();
+		drawOrder.clear();
+		batches.clear();
+		drawBuckets.clear();
+		commands.Clear();
+	}
+
+private:
+	void RecordMesh(const RenderItem& item, const RenderSnapshot& settings, uint32_t instanceCount);
+	void RecordDraw(const RenderItem& item, uint32_t instanceCount);
+	void RecordItem(const RenderItem& item, uint32_t drawIndex, const RenderSnapshot& settings);
+	void RecordInstances(const RenderBatch& batch, const RenderSnapshot& settings);
+	void RecordBucket(const DrawBucket& bucket, const RenderSnapshot& settings);
+};
+
+// Immutable once handed to the render thread. ModuleRenderer3D keeps two of them,
+// one being filled by the simulation while the other one is drawn.
+struct RenderSnapshot
+{
+	RenderView sceneView;
+	RenderView gameView;
+
+	// Shapes added through ModuleDebugDraw this frame, grid and octree included, drawn
+	// in the scene view
+	DebugDrawList debugDraw;
+
+	bool drawTextures = true;
+	bool wireframe = false;
+	bool shadedWireframe = false;
+	bool cullFace = true;
+	// Preferences limited to what the context supports, headless runs record everything.
+	// Instancing and multi-draw need the shader pipeline.
+	bool shaders = true;
+	bool instancing = true;
+	bool multiDraw = true;
+
+	float vertexNormalLength = 0.1f;
+	float faceNormalLength = 0.1f;
+	glm::vec3 vertexNormalColor = glm::vec3(1.0f);
+	glm::vec3 faceNormalColor = glm::vec3(1.0f);
+
+	// Signalled once the main context has issued every upload this frame depends on
+	GLsync uploadFence = nullptr;
+
+	void Clear()
+	{
+		sceneView.Clear();
+		gameView.Clear();
+		debugDraw.Clear();
+		uploadFence = nullptr;
+	}
+};
@@ -0,0 +1,136 @@
+#include "RenderState.h"
+
+RenderStateCache::RenderStateCache()
+{
+}
+
+void RenderStateCache::Reset()
+{
+	textureKnown = false;
+	vertexArrayKnown = false;
+	polygonMode = GL_NONE;
+	colorKnown = false;
+	programKnown = false;
+}
+
+void RenderStateCache::BindTexture(GLuint newTexture)
+{
+	if (textureKnown && texture == newTexture)
+		return;
+
+	glBindTexture(GL_TEXTURE_2D, newTexture);
+	textureKnown = true;
+	texture = newTexture;
+	stats.textureBinds++;
+}
+
+void RenderStateCache::BindVertexArray(GLuint newVertexArray)
+{
+	if (vertexArrayKnown && vertexArray == newVertexArray)
+		return;
+
+	glBindVertexArray(newVertexArray);
+	vertexArrayKnown = true;
+	vertexArray = newVertexArray;
+	stats.stateChanges++;
+}
+
+void RenderStateCache::SetPolygonMode(GLenum mode)
+{
+	if (polygonMode == mode)
+		return;
+
+	glPolygonMode(GL_FRONT_AND_BACK, mode);
+	polygonMode = mode;
+	stats.stateChanges++;
+}
+
+void RenderStateCache::SetColor(const glm::vec3& newColor)
+{
+	if (colorKnown && color == newColor)
+		return;
+
+	colorKnown = true;
+	color = newColor;
+	ApplyColor();
+}
+
+void RenderStateCache::UseProgram(const ShaderProgram* newProgram)
+{
+	if (programKnown && program == newProgram)
+		return;
+
+	glUseProgram(newProgram != nullptr ? newProgram->id : 0);
+	programKnown = true;
+	program = newProgram;
+	stats.stateChanges++;
+
+	// Each program keeps its own color, and glColor is not seen by them
+	if (colorKnown)
+		ApplyColor();
+}
+
+void RenderStateCache::ApplyColor()
+{
+	if (programKnown && program != nullptr)
+	{
+		if (program->colorLocation < 0)
+			return;
+		glUniform4f(program->colorLocation, color.x, color.y, color.z, 1.0f);
+	}
+	else
+	{
+		glColor3f(color.x, color.y, color.z);
+	}
+
+	stats.stateChanges++;
+}
+
+void RenderStateCache::DrawElements(const GeometryAllocation& geometry, GLsizei instanceCount)
+{
+	const void* firstIndex = reinterpret_cast<const void*>(static_cast<uintptr_t>(geometry.firstIndex) * sizeof(uint32_t));
+	const GLint baseVertex = static_cast<GLint>(geometry.baseVertex);
+
+	if (instanceCount > 1)
+		glDrawElementsInstancedBaseVertex(GL_TRIANGLES, geometry.indexCount, GL_UNSIGNED_INT, firstIndex, instanceCount, baseVertex);
+	else
+		glDrawElementsBaseVertex(GL_TRIANGLES, geometry.indexCount, GL_UNSIGNED_INT, firstIndex, baseVertex);
+
+	stats.draws++;
+	stats.submittedDraws += instanceCount;
+}
+
+void RenderStateCache::MultiDrawElements(const GeometryAllocation& geometry, const IndexRange* ranges, uint32_t rangeCount)
+{
+	rangeCounts.resize(rangeCount);
+	rangeOffsets.resize(rangeCount);
+	rangeBaseVertices.assign(rangeCount, static_cast<GLint>(geometry.baseVertex));
+
+	for (uint32_t i = 0; i < rangeCount; ++i)
+	{
+		rangeCounts[i] = static_cast<GLsizei>(ranges[i].indexCount);
+		rangeOffsets[i] = reinterpret_cast<const void*>(static_cast<uintptr_t>(geometry.firstIndex + ranges[i].firstIndex) * sizeof(uint32_t));
+	}
+
+	glMultiDrawElementsBaseVertex(GL_TRIANGLES, rangeCounts.data(), GL_UNSIGNED_INT, rangeOffsets.data(), static_cast<GLsizei>(rangeCount), rangeBaseVertices.data());
+
+	stats.draws++;
+	stats.submittedDraws++;
+}
+
+void RenderStateCache::DrawArrays(GLenum mode, GLint first, GLsizei count)
+{
+	glDrawArrays(mode, first, count);
+
+	stats.draws++;
+	stats.submittedDraws++;
+}
+
+void RenderStateCache::MultiDrawElementsIndirect(size_t firstCommand, GLsizei commandCount, uint32_t submittedDraws)
+{
+	const void* offset = reinterpret_cast<const void*>(firstCommand * sizeof(DrawElementsIndirectCommand));
+	glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, offset, commandCount, 0);
+
+	stats.draws++;
+	stats.submittedDraws += submittedDraws;
+}
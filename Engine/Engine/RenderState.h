@@ -0,0 +1,73 @@
+#pragma once
+
+#include "GeometryPool.h"
+#include "ShaderCache.h"
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+struct RenderStats
+{
+	uint32_t draws = 0;				// Draw calls reaching GL
+	uint32_t submittedDraws = 0;	// Meshes or instances those calls drew
+	uint32_t textureBinds = 0;
+	uint32_t stateChanges = 0;
+};
+
+// Shadows the GL state mesh draws change, so binding what is already bound never
+// reaches the driver. Anything that changes this state without going through the
+// cache (immediate mode helpers, ImGui...) must be followed by Reset.
+class RenderStateCache
+{
+public:
+	RenderStateCache();
+
+	// Forgets what is bound, the next request of each state always reaches GL
+	void Reset();
+
+	void BindTexture(GLuint texture);
+	void BindVertexArray(GLuint vertexArray);
+	void SetPolygonMode(GLenum mode);
+
+	// Goes to the color uniform of the program in use, or to glColor without one
+	void SetColor(const glm::vec3& color);
+
+	// nullptr goes back to the fixed function pipeline
+	void UseProgram(const ShaderProgram* program);
+
+	// The vertex array of the allocation page must be bound
+	void DrawElements(const GeometryAllocation& geometry, GLsizei instanceCount = 1);
+	// Several index ranges of one allocation with a single call
+	void MultiDrawElements(const GeometryAllocation& geometry, const IndexRange* ranges, uint32_t rangeCount);
+	// Non indexed primitives of the bound vertex array, used by the debug draw
+	void DrawArrays(GLenum mode, GLint first, GLsizei count);
+	// Commands are read from the bound GL_DRAW_INDIRECT_BUFFER
+	void MultiDrawElementsIndirect(size_t firstCommand, GLsizei commandCount, uint32_t submittedDraws);
+
+public:
+	RenderStats stats;
+
+private:
+	void ApplyColor();
+
+private:
+	bool textureKnown = false;
+	GLuint texture = 0;
+
+	bool vertexArrayKnown = false;
+	GLuint vertexArray = 0;
+
+	GLenum polygonMode = GL_NONE;
+
+	bool colorKnown = false;
+	glm::vec3 color = glm::vec3(1.0f);
+
+	bool programKnown = false;
+	const ShaderProgram* program = nullptr;
+
+	std::vector<GLsizei> rangeCounts;
+	std::vector<const void*> rangeOffsets;
+	std::vector<GLint> rangeBaseVertices;
+};
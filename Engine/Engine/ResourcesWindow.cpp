@@ -25,6 +25,18 @@ void ResourcesWindow::UpdateResources()
 	resources = app->resources->GetResources();
 }
 
+void ResourcesWindow::OnSceneEvents(const std::vector<SceneEvent>& events)
+{
+	for (const SceneEvent& event : events)
+	{
+		if (event.type == SceneEventType::RESOURCES_CHANGED)
+		{
+			UpdateResources();
+			return;
+		}
+	}
+}
+
 void ResourcesWindow::DrawResourceUsageTable()
 {
 	ImGui::Text("Resource Usage: %d", resources.size());
@@ -4,10 +4,11 @@
 
 #include "EditorWindow.h"
 #include "Resource.h"
+#include "SceneEvents.h"
 
 enum class ResourceType;
 
-class ResourcesWindow : public EditorWindow
+class ResourcesWindow : public EditorWindow, public SceneEventListener
 {
 public:
 	ResourcesWindow(const WindowType type, const std::string& name);
@@ -17,6 +18,8 @@ public:
 
 	void UpdateResources();
 
+	void OnSceneEvents(const std::vector<SceneEvent>& events) override;
+
 private:
 	void DrawResourceUsageTable();
 	std::string ResourceTypeToString(const ResourceType type);
@@ -0,0 +1,90 @@
+#include "SceneEvents.h"
+
+#include "GameObject.h"
+
+#include <algorithm>
+
+namespace
+{
+	thread_local std::vector<SceneEvent>* deferredBuffer = nullptr;
+}
+
+SceneEventStream::SceneEventStream()
+{
+}
+
+SceneEventStream::~SceneEventStream()
+{
+}
+
+void SceneEventStream::Record(SceneEventType type, GameObject* gameObject, ComponentType componentType)
+{
+	SceneEvent event;
+	event.type = type;
+	event.gameObject = gameObject;
+	event.componentType = componentType;
+
+	if (gameObject != nullptr)
+	{
+		event.registrySlot = gameObject->GetRegistrySlot();
+		event.registrySerial = gameObject->GetRegistrySerial();
+	}
+
+	if (deferredBuffer != nullptr)
+	{
+		deferredBuffer->push_back(event);
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(recordMutex);
+	recording.push_back(event);
+}
+
+void SceneEventStream::BeginDeferred(std::vector<SceneEvent>& buffer)
+{
+	deferredBuffer = &buffer;
+}
+
+void SceneEventStream::EndDeferred()
+{
+	deferredBuffer = nullptr;
+}
+
+void SceneEventStream::AppendDeferred(std::vector<SceneEvent>& buffer)
+{
+	if (buffer.empty())
+		return;
+
+	std::lock_guard<std::mutex> lock(recordMutex);
+	recording.insert(recording.end(), buffer.begin(), buffer.end());
+	buffer.clear();
+}
+
+void SceneEventStream::Subscribe(SceneEventListener* listener)
+{
+	if (std::find(listeners.begin(), listeners.end(), listener) == listeners.end())
+		listeners.push_back(listener);
+}
+
+void SceneEventStream::Unsubscribe(SceneEventListener* listener)
+{
+	listeners.erase(std::remove(listeners.begin(), listeners.end(), listener), listeners.end());
+}
+
+void SceneEventStream::Dispatch()
+{
+	{
+		std::lock_guard<std::mutex> lock(recordMutex);
+		dispatching.swap(recording);
+	}
+
+	lastDispatchCount = dispatching.size();
+
+	if (!dispatching.empty())
+	{
+		for (SceneEventListener* listener : listeners)
+			listener->OnSceneEvents(dispatching);
+	}
+
+	dispatching.clear();
+}
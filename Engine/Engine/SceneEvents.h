@@ -0,0 +1,70 @@
+#pragma once
+
+#include "Component.h"
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+class GameObject;
+
+enum class SceneEventType
+{
+	OBJECT_CREATED,
+	OBJECT_DESTROYED,
+	TRANSFORM_CHANGED,
+	REPARENTED,
+	COMPONENT_ADDED,
+	COMPONENT_REMOVED,
+	STATE_CHANGED,		// Active or static flag, or the material look, changed
+	RESOURCES_CHANGED
+};
+
+// gameObject may already be deleted when the event is delivered. Use
+// SceneRegistry::Resolve before dereferencing it.
+struct SceneEvent
+{
+	SceneEventType type;
+	GameObject* gameObject = nullptr;
+	uint32_t registrySlot = UINT32_MAX;
+	uint64_t registrySerial = 0;
+	ComponentType componentType = ComponentType::NONE;
+};
+
+class SceneEventListener
+{
+public:
+	virtual ~SceneEventListener() {}
+
+	virtual void OnSceneEvents(const std::vector<SceneEvent>& events) = 0;
+};
+
+class SceneEventStream
+{
+public:
+	SceneEventStream();
+	~SceneEventStream();
+
+	void Record(SceneEventType type, GameObject* gameObject, ComponentType componentType = ComponentType::NONE);
+
+	// While deferred, events recorded on the calling thread go to its own buffer.
+	// Buffers are appended afterwards in a fixed order so delivery stays deterministic.
+	void BeginDeferred(std::vector<SceneEvent>& buffer);
+	void EndDeferred();
+	void AppendDeferred(std::vector<SceneEvent>& buffer);
+
+	void Subscribe(SceneEventListener* listener);
+	void Unsubscribe(SceneEventListener* listener);
+
+	void Dispatch();
+
+	size_t GetLastDispatchCount() const { return lastDispatchCount; }
+
+private:
+	std::mutex recordMutex;
+	std::vector<SceneEvent> recording;
+	std::vector<SceneEvent> dispatching;
+
+	std::vector<SceneEventListener*> listeners;
+	size_t lastDispatchCount = 0;
+};
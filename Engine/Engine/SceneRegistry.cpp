@@ -0,0 +1,122 @@
+#include "SceneRegistry.h"
+
+#include "GameObject.h"
+
+SceneRegistry::SceneRegistry()
+{
+}
+
+SceneRegistry::~SceneRegistry()
+{
+}
+
+uint32_t SceneRegistry::Register(GameObject* gameObject)
+{
+	uint32_t slot;
+	if (!freeSlots.empty())
+	{
+		slot = freeSlots.back();
+		freeSlots.pop_back();
+		slots[slot] = gameObject;
+		slotSerials[slot] = nextSerial;
+	}
+	else
+	{
+		slot = static_cast<uint32_t>(slots.size());
+		slots.push_back(gameObject);
+		slotSerials.push_back(nextSerial);
+	}
+
+	gameObject->registrySerial = nextSerial++;
+
+	liveCount++;
+	hierarchyDirty = true;
+
+	uidIndex[gameObject->uid] = gameObject;
+
+	return slot;
+}
+
+void SceneRegistry::Unregister(GameObject* gameObject)
+{
+	const uint32_t slot = gameObject->registrySlot;
+	if (slot >= slots.size() || slots[slot] != gameObject)
+		return;
+
+	slots[slot] = nullptr;
+	slotSerials[slot] = 0;
+	freeSlots.push_back(slot);
+
+	liveCount--;
+	hierarchyDirty = true;
+
+	auto it = uidIndex.find(gameObject->uid);
+	if (it != uidIndex.end() && it->second == gameObject)
+		uidIndex.erase(it);
+
+	if (gameObject == root)
+		root = nullptr;
+}
+
+void SceneRegistry::SetUID(GameObject* gameObject, const UID& uid)
+{
+	auto it = uidIndex.find(gameObject->uid);
+	if (it != uidIndex.end() && it->second == gameObject)
+		uidIndex.erase(it);
+
+	gameObject->uid = uid;
+	uidIndex[uid] = gameObject;
+}
+
+GameObject* SceneRegistry::Find(const UID& uid) const
+{
+	auto it = uidIndex.find(uid);
+	return it != uidIndex.end() ? it->second : nullptr;
+}
+
+GameObject* SceneRegistry::Resolve(const SceneEvent& event) const
+{
+	if (event.registrySlot >= slots.size() || slotSerials[event.registrySlot] != event.registrySerial)
+		return nullptr;
+
+	return slots[event.registrySlot];
+}
+
+void SceneRegistry::SetRoot(GameObject* root)
+{
+	this->root = root;
+	hierarchyDirty = true;
+}
+
+const std::vector<GameObject*>& SceneRegistry::GetObjects()
+{
+	if (hierarchyDirty)
+		RebuildHierarchy();
+
+	return hierarchy;
+}
+
+void SceneRegistry::RebuildHierarchy()
+{
+	hierarchy.clear();
+	traversalStack.clear();
+
+	if (root != nullptr)
+	{
+		for (auto it = root->children.rbegin(); it != root->children.rend(); ++it)
+			traversalStack.push_back(*it);
+	}
+
+	while (!traversalStack.empty())
+	{
+		GameObject* gameObject = traversalStack.back();
+		traversalStack.pop_back();
+
+		hierarchy.push_back(gameObject);
+
+		for (auto it = gameObject->children.rbegin(); it != gameObject->children.rend(); ++it)
+			traversalStack.push_back(*it);
+	}
+
+	hierarchyDirty = false;
+}
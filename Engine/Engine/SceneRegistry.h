@@ -0,0 +1,62 @@
+#pragma once
+
+#include "GameObject.h"
+#include "SceneEvents.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+class SceneRegistry
+{
+public:
+	SceneRegistry();
+	~SceneRegistry();
+
+	uint32_t Register(GameObject* gameObject);
+	void Unregister(GameObject* gameObject);
+
+	void SetRoot(GameObject* root);
+	void MarkHierarchyDirty() { hierarchyDirty = true; }
+
+	void SetUID(GameObject* gameObject, const UID& uid);
+	GameObject* Find(const UID& uid) const;
+
+	GameObject* GetObject(uint32_t slot) const { return slot < slots.size() ? slots[slot] : nullptr; }
+	GameObject* Resolve(const SceneEvent& event) const;
+	size_t GetObjectCount() const { return liveCount; }
+
+	// Live objects below the root in hierarchy order (parents before their children)
+	const std::vector<GameObject*>& GetObjects();
+
+	template <typename Func>
+	void ForEach(Func&& func, ComponentSignature required = 0)
+	{
+		for (GameObject* gameObject : GetObjects())
+		{
+			if (gameObject->HasComponents(required))
+				func(gameObject);
+		}
+	}
+
+private:
+	void RebuildHierarchy();
+
+public:
+	static constexpr uint32_t INVALID_SLOT = UINT32_MAX;
+
+private:
+	GameObject* root = nullptr;
+
+	std::vector<GameObject*> slots;
+	std::vector<uint64_t> slotSerials;
+	uint64_t nextSerial = 1;
+	std::vector<uint32_t> freeSlots;
+	size_t liveCount = 0;
+
+	std::unordered_map<UID, GameObject*, UIDHash> uidIndex;
+
+	std::vector<GameObject*> hierarchy;
+	std::vector<GameObject*> traversalStack;
+	bool hierarchyDirty = true;
+};
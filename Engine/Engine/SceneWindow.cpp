@@ -106,7 +106,7 @@ void SceneWindow::DrawWindow()
 			ImVec2 windowPos = ImGui::GetWindowPos();
 			ImVec2 topRightPos = ImVec2(windowPos.x + windowSize.x - 140, windowPos.y + 50);
 			ImGui::SetNextWindowPos(topRightPos);
-			ImGui::SetNextWindowSize(ImVec2(130, 125));
+			ImGui::SetNextWindowSize(ImVec2(130, 203));
 			ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2(10, 10));
 			if (ImGui::Begin("SceneStatsOverlay", nullptr, ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize))
 			{
@@ -115,6 +115,11 @@ void SceneWindow::DrawWindow()
 				ImGui::Text("Tris: %s", formatNumber(app->scene->sceneCamera->triangleCount).c_str());
 				ImGui::Text("Verts: %s", formatNumber(app->scene->sceneCamera->vertexCount).c_str());
 				ImGui::Text("Meshes: %d", app->scene->sceneCamera->meshCount);
+				ImGui::Text("Clusters: %d/%d", app->scene->sceneCamera->visibleClusterCount, app->scene->sceneCamera->clusterCount);
+				ImGui::Text("Draws: %u", app->renderer3D->renderStats.submittedDraws);
+				ImGui::Text("API Calls: %u", app->renderer3D->renderStats.draws);
+				ImGui::Text("Tex Binds: %u", app->renderer3D->renderStats.textureBinds);
+				ImGui::Text("State: %u", app->renderer3D->renderStats.stateChanges);
 				ImGui::Text("Screen: %.fx%.f", windowSize.x, windowSize.y);
 			}
 			ImGui::End();
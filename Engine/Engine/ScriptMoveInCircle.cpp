@@ -29,15 +29,15 @@ void ScriptMoveInCircle::Reset()
     Start();
 }
 
-void ScriptMoveInCircle::Update()
+void ScriptMoveInCircle::FixedUpdate()
 {
     float angularSpeed = (speed / 1000.0f) / radius;
 
-    angle += angularSpeed * app->time.GetDeltaTime();
+    angle += angularSpeed * app->time.GetFixedDeltaTime();
 
     float x = initialPosition.x + radius * cos(angle);
     float z = initialPosition.z + radius * sin(angle);
 
     gameObject->transform->position = glm::vec3(x, initialPosition.y, z);
-    gameObject->transform->UpdateTransform();
+    gameObject->transform->updateTransform = true;
 }
\ No newline at end of file
@@ -12,7 +12,10 @@ public:
 
 	void Start() override;
 	void Reset() override;
-	void Update() override;
+	void FixedUpdate() override;
+
+	// Only writes its own transform
+	bool IsThreadSafe() const override { return true; }
 
 private:
 	float speed;
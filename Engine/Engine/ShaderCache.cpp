@@ -0,0 +1,238 @@
+#include "ShaderCache.h"
+#include "App.h"
+
+#include <glm/gtc/type_ptr.hpp>
+
+static const char* VERTEX_SHADER = R"(
+layout(location = 0) in vec3 position;
+#ifdef VERTEX_COLOR
+layout(location = 3) in vec4 vertexColor;
+out vec4 varyingColor;
+#else
+layout(location = 4) in mat4 transform;
+#endif
+#ifdef TEXTURED
+layout(location = 8) in vec2 texCoord;
+out vec2 uv;
+#endif
+
+layout(std140) uniform Camera
+{
+	mat4 view;
+	mat4 projection;
+	mat4 viewProjection;
+};
+
+void main()
+{
+#ifdef VERTEX_COLOR
+	gl_Position = viewProjection * vec4(position, 1.0);
+	varyingColor = vertexColor;
+#else
+	gl_Position = viewProjection * transform * vec4(position, 1.0);
+#endif
+#ifdef TEXTURED
+	uv = texCoord;
+#endif
+#ifdef WIREFRAME
+	gl_Position.z -= 0.0001 * gl_Position.w;
+#endif
+}
+)";
+
+static const char* FRAGMENT_SHADER = R"(
+#ifdef VERTEX_COLOR
+in vec4 varyingColor;
+#else
+uniform vec4 color;
+#endif
+#ifdef TEXTURED
+uniform sampler2D diffuse;
+in vec2 uv;
+#endif
+out vec4 fragColor;
+
+void main()
+{
+#ifdef VERTEX_COLOR
+	fragColor = varyingColor;
+#else
+	fragColor = color;
+#endif
+#ifdef TEXTURED
+	fragColor *= texture(diffuse, uv);
+#endif
+}
+)";
+
+static GLuint CompileShader(GLenum type, const std::string& defines, const char* source)
+{
+	const std::string header = "#version 330\n" + defines;
+	const char* sources[] = { header.c_str(), source };
+
+	GLuint shader = glCreateShader(type);
+	glShaderSource(shader, 2, sources, nullptr);
+	glCompileShader(shader);
+
+	GLint compiled = GL_FALSE;
+	glGetShaderiv(shader, GL_COMPILE_STATUS, &compiled);
+	if (compiled != GL_TRUE)
+	{
+		char log[512];
+		glGetShaderInfoLog(shader, sizeof(log), nullptr, log);
+		LOG(LogType::LOG_ERROR, "Shader failed to compile: %s", log);
+		glDeleteShader(shader);
+		return 0;
+	}
+
+	return shader;
+}
+
+ShaderCache::ShaderCache()
+{
+}
+
+ShaderCache::~ShaderCache()
+{
+}
+
+bool ShaderCache::Init()
+{
+	if (initialized)
+		return available;
+
+	initialized = true;
+
+	if (!GLEW_VERSION_3_3)
+	{
+		LOG(LogType::LOG_WARNING, "Shaders need OpenGL 3.3, using the fixed function pipeline");
+		return false;
+	}
+
+	variants[static_cast<int>(ShaderType::UNLIT)] = Build("");
+	variants[static_cast<int>(ShaderType::TEXTURED)] = Build("#define TEXTURED\n");
+	variants[static_cast<int>(ShaderType::WIREFRAME)] = Build("#define WIREFRAME\n");
+	variants[static_cast<int>(ShaderType::DEBUG_DRAW)] = Build("#define VERTEX_COLOR\n");
+
+	for (const ShaderProgram* program : variants)
+	{
+		if (program == nullptr)
+		{
+			LOG(LogType::LOG_WARNING, "Using the fixed function pipeline, a shader could not be built");
+			Destroy();
+			initialized = true;
+			return false;
+		}
+	}
+
+	glGenBuffers(1, &cameraBuffer);
+	glBindBuffer(GL_UNIFORM_BUFFER, cameraBuffer);
+	glBufferData(GL_UNIFORM_BUFFER, 3 * sizeof(glm::mat4), nullptr, GL_DYNAMIC_DRAW);
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+	available = true;
+	LOG(LogType::LOG_INFO, "Built %d shader programs", static_cast<int>(programs.size()));
+
+	return true;
+}
+
+void ShaderCache::Destroy()
+{
+	for (auto& entry : programs)
+		glDeleteProgram(entry.second.id);
+	programs.clear();
+
+	for (const ShaderProgram*& program : variants)
+		program = nullptr;
+
+	if (cameraBuffer != 0)
+		glDeleteBuffers(1, &cameraBuffer);
+
+	cameraBuffer = 0;
+	available = false;
+	initialized = false;
+}
+
+const ShaderProgram* ShaderCache::Get(ShaderType type) const
+{
+	return available ? variants[static_cast<int>(type)] : nullptr;
+}
+
+const ShaderProgram* ShaderCache::Build(const std::string& defines)
+{
+	auto cached = programs.find(defines);
+	if (cached != programs.end())
+		return &cached->second;
+
+	GLuint vertexShader = CompileShader(GL_VERTEX_SHADER, defines, VERTEX_SHADER);
+	GLuint fragmentShader = CompileShader(GL_FRAGMENT_SHADER, defines, FRAGMENT_SHADER);
+
+	GLuint id = 0;
+	if (vertexShader != 0 && fragmentShader != 0)
+	{
+		id = glCreateProgram();
+		glAttachShader(id, vertexShader);
+		glAttachShader(id, fragmentShader);
+		glLinkProgram(id);
+
+		GLint linked = GL_FALSE;
+		glGetProgramiv(id, GL_LINK_STATUS, &linked);
+		if (linked != GL_TRUE)
+		{
+			char log[512];
+			glGetProgramInfoLog(id, sizeof(log), nullptr, log);
+			LOG(LogType::LOG_ERROR, "Shader failed to link: %s", log);
+			glDeleteProgram(id);
+			id = 0;
+		}
+	}
+
+	if (vertexShader != 0)
+		glDeleteShader(vertexShader);
+	if (fragmentShader != 0)
+		glDeleteShader(fragmentShader);
+
+	if (id == 0)
+		return nullptr;
+
+	// Block bindings and sampler units are program state, so they hold in every context
+	glUniformBlockBinding(id, glGetUniformBlockIndex(id, "Camera"), CAMERA_BINDING);
+
+	glUseProgram(id);
+	const GLint diffuseLocation = glGetUniformLocation(id, "diffuse");
+	if (diffuseLocation >= 0)
+		glUniform1i(diffuseLocation, 0);
+	glUseProgram(0);
+
+	ShaderProgram& program = programs[defines];
+	program.id = id;
+	program.colorLocation = glGetUniformLocation(id, "color");
+
+	return &program;
+}
+
+void ShaderCache::UpdateCamera(const glm::mat4& projection, const glm::mat4& view)
+{
+	if (!available)
+		return;
+
+	const glm::mat4 camera[3] = { view, projection, projection * view };
+
+	// Binding points are context state, the render thread binds the buffer for itself
+	glBindBufferBase(GL_UNIFORM_BUFFER, CAMERA_BINDING, cameraBuffer);
+	glBufferData(GL_UNIFORM_BUFFER, sizeof(camera), nullptr, GL_DYNAMIC_DRAW);
+	glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(camera), glm::value_ptr(camera[0]));
+}
+
+const char* ShaderCache::GetTypeName(ShaderType type)
+{
+	switch (type)
+	{
+	case ShaderType::UNLIT: return "Unlit";
+	case ShaderType::TEXTURED: return "Textured";
+	case ShaderType::WIREFRAME: return "Wireframe";
+	case ShaderType::DEBUG_DRAW: return "Debug Draw";
+	}
+
+	return "Unknown";
+}
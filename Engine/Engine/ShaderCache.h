@@ -0,0 +1,75 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+enum class ShaderType : uint8_t
+{
+	UNLIT = 0,		// Material color
+	TEXTURED = 1,	// Material color times the diffuse texture
+	WIREFRAME = 2,	// Flat color, pulled slightly towards the camera to sit on top of shaded meshes
+	DEBUG_DRAW = 3	// World space vertices with their own color, see DebugDrawList
+};
+
+struct ShaderProgram
+{
+	GLuint id = 0;
+	GLint colorLocation = -1;
+};
+
+// Vertex attribute locations of the programs. They match the slots some drivers alias
+// with the fixed function arrays holding the same data, so a vertex array can feed both
+// pipelines. The per-draw transform is a mat4 and takes four consecutive locations.
+namespace ShaderAttribute
+{
+	const GLuint POSITION = 0;
+	const GLuint NORMAL = 2;
+	const GLuint COLOR = 3;
+	const GLuint TRANSFORM = 4;
+	const GLuint TEXCOORD = 8;
+}
+
+// Builds the programs the renderer draws meshes and debug lines with, one per combination
+// of defines over the same sources. Camera matrices come from a uniform buffer shared by
+// every program, the world matrix of each draw is fetched by instance index from the
+// per-draw transforms. The selection outline stays fixed function.
+class ShaderCache
+{
+public:
+	ShaderCache();
+	~ShaderCache();
+
+	// Called from the main context before the render thread starts, programs and the
+	// camera buffer are shared with it. Every variant is built up front so the first
+	// frames do not stall on the compiler. Returns false when one of them fails, the
+	// renderer then keeps the fixed function pipeline.
+	bool Init();
+	void Destroy();
+
+	bool IsAvailable() const { return available; }
+
+	const ShaderProgram* Get(ShaderType type) const;
+
+	// Binds the camera buffer to its binding point in the current context and fills it
+	void UpdateCamera(const glm::mat4& projection, const glm::mat4& view);
+
+	static const char* GetTypeName(ShaderType type);
+
+private:
+	const ShaderProgram* Build(const std::string& defines);
+
+private:
+	static const GLuint CAMERA_BINDING = 0;
+	static const int SHADER_TYPE_COUNT = 4;
+
+	// Programs keyed by the define lines they were built with
+	std::unordered_map<std::string, ShaderProgram> programs;
+	const ShaderProgram* variants[SHADER_TYPE_COUNT] = {};
+
+	GLuint cameraBuffer = 0;
+	bool initialized = false;
+	bool available = false;
+};
@@ -0,0 +1,288 @@
+#include "StaticBatcher.h"
+#include "App.h"
+#include "GameObject.h"
+#include "ComponentMesh.h"
+#include "ComponentMaterial.h"
+#include "ComponentTransform.h"
+
+#include <cstring>
+#include <map>
+#include <set>
+#include <tuple>
+
+struct StaticMember
+{
+	const Mesh* mesh;
+	glm::mat4 transform;
+};
+
+struct StaticGroup
+{
+	GLuint textureId = 0;
+	glm::vec4 color = glm::vec4(1.0f);
+	std::vector<StaticMember> members;
+};
+
+StaticBatcher::StaticBatcher()
+{
+}
+
+StaticBatcher::~StaticBatcher()
+{
+}
+
+void StaticBatcher::OnSceneEvents(const std::vector<SceneEvent>& events)
+{
+	for (const SceneEvent& event : events)
+	{
+		if (rebuildAll)
+			return;
+
+		switch (event.type)
+		{
+		case SceneEventType::OBJECT_DESTROYED:
+			if (Contains(event.gameObject))
+				dirtyObjects.insert(event.gameObject);
+			break;
+		case SceneEventType::TRANSFORM_CHANGED:
+		case SceneEventType::COMPONENT_ADDED:
+		case SceneEventType::COMPONENT_REMOVED:
+		{
+			GameObject* gameObject = app->scene->sceneRegistry.Resolve(event);
+			if (Contains(event.gameObject) || (gameObject != nullptr && gameObject->isStatic))
+				dirtyObjects.insert(event.gameObject);
+			break;
+		}
+		case SceneEventType::REPARENTED:
+		case SceneEventType::STATE_CHANGED:
+			// Activity is inherited, a parent being toggled or moved can hide or show static children
+			if (Contains(event.gameObject))
+				dirtyObjects.insert(event.gameObject);
+			MarkHierarchyDirty(app->scene->sceneRegistry.Resolve(event));
+			break;
+		case SceneEventType::RESOURCES_CHANGED:
+			// Merged geometry was copied from resources that may be gone now
+			rebuildAll = !objectClusters.empty();
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+void StaticBatcher::MarkHierarchyDirty(const GameObject* gameObject)
+{
+	if (gameObject == nullptr)
+		return;
+
+	if (gameObject->isStatic || Contains(gameObject))
+		dirtyObjects.insert(gameObject);
+
+	for (const GameObject* child : gameObject->children)
+		MarkHierarchyDirty(child);
+}
+
+void StaticBatcher::Update(const std::vector<ComponentMesh*>& renderables)
+{
+	retiredMeshes.clear();
+
+	if (enabled != wasEnabled)
+	{
+		wasEnabled = enabled;
+		rebuildAll = true;
+	}
+
+	if (!rebuildAll && dirtyObjects.empty())
+		return;
+
+	if (rebuildAll || !enabled)
+	{
+		for (StaticCluster& cluster : clusters)
+			retiredMeshes.push_back(std::move(cluster.mesh));
+		clusters.clear();
+		clusterKeys.clear();
+		objectClusters.clear();
+	}
+
+	if (enabled)
+		Rebuild(renderables);
+
+	rebuildAll = false;
+	dirtyObjects.clear();
+}
+
+void StaticBatcher::Clear()
+{
+	clusters.clear();
+	clusterKeys.clear();
+	objectClusters.clear();
+	dirtyObjects.clear();
+	retiredMeshes.clear();
+	rebuildAll = true;
+}
+
+void StaticBatcher::Rebuild(const std::vector<ComponentMesh*>& renderables)
+{
+	const int64_t start = Timer::NowNs();
+
+	// Clusters the changed objects leave, plus the ones they join below
+	std::set<StaticClusterKey> affected;
+	for (const GameObject* gameObject : dirtyObjects)
+	{
+		auto it = objectClusters.find(gameObject);
+		if (it != objectClusters.end())
+		{
+			affected.insert(it->second);
+			objectClusters.erase(it);
+		}
+	}
+
+	// Grouped by texture and color first, then by grid cell of the object center
+	std::vector<std::pair<ComponentMesh*, StaticClusterKey>> candidates;
+	for (ComponentMesh* meshComponent : renderables)
+	{
+		GameObject* gameObject = meshComponent->gameObject;
+		const Mesh* mesh = meshComponent->mesh;
+
+		if (!gameObject->isStatic || mesh == nullptr || mesh->verticesCount == 0 || gameObject->transform == nullptr || !gameObject->activeInHierarchy)
+			continue;
+
+		const AABB bounds = mesh->GetAABB(gameObject->transform->globalTransform);
+		const glm::ivec3 cell = glm::ivec3(glm::floor((bounds.min + bounds.max) * 0.5f / clusterSize));
+
+		const GLuint textureId = gameObject->material != nullptr ? gameObject->material->textureId : 0;
+		const glm::vec4& color = mesh->diffuseColor;
+
+		const StaticClusterKey key = std::make_tuple(textureId, color.r, color.g, color.b, color.a, cell.x, cell.y, cell.z);
+		candidates.push_back({ meshComponent, key });
+
+		if (rebuildAll || dirtyObjects.find(gameObject) != dirtyObjects.end())
+			affected.insert(key);
+	}
+
+	if (affected.empty())
+		return;
+
+	// Untouched members of an affected cluster are merged again with the changed ones
+	std::map<StaticClusterKey, StaticGroup> groups;
+	for (const auto& candidate : candidates)
+	{
+		if (affected.find(candidate.second) == affected.end())
+			continue;
+
+		ComponentMesh* meshComponent = candidate.first;
+		GameObject* gameObject = meshComponent->gameObject;
+
+		StaticGroup& group = groups[candidate.second];
+		group.textureId = gameObject->material != nullptr ? gameObject->material->textureId : 0;
+		group.color = meshComponent->mesh->diffuseColor;
+		group.members.push_back({ meshComponent->mesh, gameObject->transform->globalTransform });
+
+		objectClusters[gameObject] = candidate.second;
+	}
+
+	for (size_t i = 0; i < clusters.size();)
+	{
+		if (affected.find(clusterKeys[i]) == affected.end())
+		{
+			++i;
+			continue;
+		}
+
+		retiredMeshes.push_back(std::move(clusters[i].mesh));
+		if (i != clusters.size() - 1)
+		{
+			clusters[i] = std::move(clusters.back());
+			clusterKeys[i] = clusterKeys.back();
+		}
+		clusters.pop_back();
+		clusterKeys.pop_back();
+	}
+
+	const size_t firstCluster = clusters.size();
+
+	std::vector<StaticGroup*> groupList;
+	groupList.reserve(groups.size());
+	for (auto& entry : groups)
+	{
+		groupList.push_back(&entry.second);
+		clusterKeys.push_back(entry.first);
+	}
+
+	clusters.resize(firstCluster + groupList.size());
+
+	// Pre-transforming the vertices is the expensive part and every cluster is independent
+	app->jobs.ParallelFor(groupList.size(), 1, [this, &groupList, firstCluster](size_t begin, size_t end)
+		{
+			for (size_t g = begin; g < end; ++g)
+			{
+				const StaticGroup& group = *groupList[g];
+
+				uint vertexCount = 0;
+				uint indexCount = 0;
+				for (const StaticMember& member : group.members)
+				{
+					vertexCount += member.mesh->verticesCount;
+					indexCount += member.mesh->indicesCount;
+				}
+
+				Mesh* merged = new Mesh();
+				merged->verticesCount = vertexCount;
+				merged->normalsCount = vertexCount;
+				merged->texCoordsCount = vertexCount;
+				merged->indicesCount = indexCount;
+				merged->vertices = new float[vertexCount * 3];
+				merged->normals = new float[vertexCount * 3];
+				merged->texCoords = new float[vertexCount * 2];
+				merged->indices = new uint[indexCount];
+				merged->diffuseColor = group.color;
+
+				memset(merged->normals, 0, sizeof(float) * vertexCount * 3);
+				memset(merged->texCoords, 0, sizeof(float) * vertexCount * 2);
+
+				uint baseVertex = 0;
+				uint baseIndex = 0;
+				for (const StaticMember& member : group.members)
+				{
+					const Mesh* mesh = member.mesh;
+					const glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(member.transform)));
+
+					for (uint i = 0; i < mesh->verticesCount; ++i)
+					{
+						const glm::vec3 position = glm::vec3(member.transform * glm::vec4(mesh->vertices[i * 3], mesh->vertices[i * 3 + 1], mesh->vertices[i * 3 + 2], 1.0f));
+						memcpy(&merged->vertices[(baseVertex + i) * 3], &position[0], sizeof(float) * 3);
+
+						if (i < mesh->normalsCount)
+						{
+							const glm::vec3 normal = glm::normalize(normalMatrix * glm::vec3(mesh->normals[i * 3], mesh->normals[i * 3 + 1], mesh->normals[i * 3 + 2]));
+							memcpy(&merged->normals[(baseVertex + i) * 3], &normal[0], sizeof(float) * 3);
+						}
+
+						if (i < mesh->texCoordsCount)
+							memcpy(&merged->texCoords[(baseVertex + i) * 2], &mesh->texCoords[i * 2], sizeof(float) * 2);
+					}
+
+					for (uint i = 0; i < mesh->indicesCount; ++i)
+						merged->indices[baseIndex + i] = mesh->indices[i] + baseVertex;
+
+					baseVertex += mesh->verticesCount;
+					baseIndex += mesh->indicesCount;
+				}
+
+				StaticCluster& cluster = clusters[firstCluster + g];
+				cluster.mesh.reset(merged);
+				cluster.textureId = group.textureId;
+				cluster.objectCount = static_cast<uint32_t>(group.members.size());
+			}
+		});
+
+	// Buffers are uploaded from the main context, the render thread waits on the snapshot fence
+	for (size_t i = firstCluster; i < clusters.size(); ++i)
+	{
+		clusters[i].mesh->InitMesh(!app->IsHeadless());
+		clusters[i].bounds = clusters[i].mesh->GetAABB();
+	}
+
+	LOG(LogType::LOG_INFO, "Rebuilt %d of %d static clusters (%d static objects) in %.2f ms",
+		static_cast<int>(groupList.size()), static_cast<int>(clusters.size()), static_cast<int>(objectClusters.size()), (Timer::NowNs() - start) / 1000000.0);
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "Mesh.h"
+#include "SceneEvents.h"
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <memory>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+class ComponentMesh;
+
+// Texture, color and grid cell shared by the objects merged into one cluster
+typedef std::tuple<GLuint, float, float, float, float, int, int, int> StaticClusterKey;
+
+// Geometry of static objects sharing texture and color, pre-transformed to world
+// space and merged. Clusters are cut on a grid so they can still be culled.
+struct StaticCluster
+{
+	std::unique_ptr<Mesh> mesh;
+	GLuint textureId = 0;
+	AABB bounds;
+	uint32_t objectCount = 0;
+};
+
+// Merges every active object marked isStatic into StaticClusters. Scene events that
+// touch static content only rebuild the clusters the changed objects were in and end up
+// in; the objects themselves stay in the scene for selection, picking and editor decorations.
+class StaticBatcher : public SceneEventListener
+{
+public:
+	StaticBatcher();
+	~StaticBatcher();
+
+	void OnSceneEvents(const std::vector<SceneEvent>& events) override;
+
+	// Main thread, before the snapshot is built. Rebuilds the affected clusters if needed.
+	void Update(const std::vector<ComponentMesh*>& renderables);
+	void Clear();
+
+	bool Contains(const GameObject* gameObject) const { return objectClusters.find(gameObject) != objectClusters.end(); }
+	const std::vector<StaticCluster>& GetClusters() const { return clusters; }
+
+public:
+	bool enabled = true;
+	float clusterSize = 32.0f;
+
+private:
+	void Rebuild(const std::vector<ComponentMesh*>& renderables);
+	void MarkHierarchyDirty(const GameObject* gameObject);
+
+private:
+	std::vector<StaticCluster> clusters;
+	std::vector<StaticClusterKey> clusterKeys;
+	std::unordered_map<const GameObject*, StaticClusterKey> objectClusters;
+
+	// May hold destroyed objects, only used to look up the clusters they were in
+	std::unordered_set<const GameObject*> dirtyObjects;
+
+	// The render thread may still be drawing last frame's clusters, they are
+	// released one frame later
+	std::vector<std::unique_ptr<Mesh>> retiredMeshes;
+
+	bool rebuildAll = true;
+	bool wasEnabled = true;
+};
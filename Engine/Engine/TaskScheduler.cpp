@@ -0,0 +1,79 @@
+#include "TaskScheduler.h"
+#include "App.h"
+#include "Timer.h"
+
+#include <climits>
+
+TaskScheduler::TaskScheduler()
+{
+}
+
+TaskScheduler::~TaskScheduler()
+{
+	Clear();
+}
+
+void TaskScheduler::Add(BackgroundTask* task)
+{
+	tasks.emplace_back(task);
+}
+
+void TaskScheduler::Update()
+{
+	const int64_t start = Timer::NowNs();
+	const int64_t deadline = start + static_cast<int64_t>(frameBudgetMs * 1000000.0f);
+
+	// Tasks are stepped in the order they were added, the oldest one gets the budget first
+	for (size_t i = 0; i < tasks.size();)
+	{
+		BackgroundTask* task = tasks[i].get();
+
+		if (task->mode == TaskMode::WORKER)
+		{
+			if (task->inFlight && task->counter.IsDone())
+				task->inFlight = false;
+
+			if (!task->inFlight && !task->finished.load(std::memory_order_acquire))
+			{
+				task->inFlight = true;
+				app->jobs.Submit([task]()
+					{
+						if (task->Step(INT64_MAX))
+							task->finished.store(true, std::memory_order_release);
+					}, &task->counter);
+			}
+		}
+		else if (Timer::NowNs() < deadline && task->Step(deadline))
+		{
+			task->finished.store(true, std::memory_order_release);
+		}
+
+		if (!task->inFlight && task->finished.load(std::memory_order_acquire))
+		{
+			// Complete may add new tasks, the vector can grow under our feet
+			std::unique_ptr<BackgroundTask> done = std::move(tasks[i]);
+			tasks.erase(tasks.begin() + i);
+			done->Complete();
+			continue;
+		}
+
+		++i;
+	}
+
+	lastFrameMs = static_cast<float>((Timer::NowNs() - start) / 1000000.0);
+}
+
+void TaskScheduler::WaitInFlight()
+{
+	for (const auto& task : tasks)
+	{
+		if (task->inFlight)
+			app->jobs.Wait(task->counter);
+	}
+}
+
+void TaskScheduler::Clear()
+{
+	WaitInFlight();
+	tasks.clear();
+}
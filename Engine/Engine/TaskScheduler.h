@@ -0,0 +1,76 @@
+#pragma once
+
+#include "JobSystem.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+enum class TaskMode
+{
+	WORKER,			// Each step runs as a job, off the main thread
+	MAIN_THREAD		// Each step runs on the main thread with what is left of the frame budget
+};
+
+// Work too long to fit in a frame. The scheduler keeps calling Step until it returns
+// true, then calls Complete on the main thread.
+class BackgroundTask
+{
+public:
+	BackgroundTask(const std::string& name, TaskMode mode) : name(name), mode(mode) {}
+	virtual ~BackgroundTask() {}
+
+	// MAIN_THREAD tasks must return once Timer::NowNs() passes the deadline.
+	// WORKER tasks get no deadline and may do all their work in one step
+	virtual bool Step(int64_t deadlineNs) = 0;
+	virtual void Complete() {}
+
+	const std::string& GetName() const { return name; }
+	TaskMode GetMode() const { return mode; }
+	float GetProgress() const { return progress.load(std::memory_order_relaxed); }
+
+protected:
+	void SetProgress(float value) { progress.store(value, std::memory_order_relaxed); }
+
+private:
+	friend class TaskScheduler;
+
+	std::string name;
+	TaskMode mode;
+	std::atomic<float> progress{ 0.0f };
+
+	JobCounter counter;
+	std::atomic<bool> finished{ false };
+	bool inFlight = false;
+};
+
+class TaskScheduler
+{
+public:
+	TaskScheduler();
+	~TaskScheduler();
+
+	// Takes ownership of the task
+	void Add(BackgroundTask* task);
+
+	// Called once per frame on the main thread
+	void Update();
+
+	// Waits for the steps already running on workers, the tasks keep going next Update
+	void WaitInFlight();
+	// Waits for the steps already running on workers and drops every task without completing it
+	void Clear();
+
+	bool HasTasks() const { return !tasks.empty(); }
+	const std::vector<std::unique_ptr<BackgroundTask>>& GetTasks() const { return tasks; }
+	float GetLastFrameMs() const { return lastFrameMs; }
+
+public:
+	float frameBudgetMs = 4.0f;
+
+private:
+	std::vector<std::unique_ptr<BackgroundTask>> tasks;
+	float lastFrameMs = 0.0f;
+};
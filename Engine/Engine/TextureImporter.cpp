@@ -1,4 +1,5 @@
 #include "TextureImporter.h"
+#include "App.h"
 #include "Logger.h"
 
 #include <IL/il.h>
@@ -7,6 +8,11 @@
 
 #include <vector>
 #include <fstream>
+#include <mutex>
+
+// DevIL keeps the bound image as global state, textures can be saved on workers
+// while the main thread loads others
+static std::mutex devilMutex;
 
 TextureImporter::TextureImporter()
 {
@@ -21,6 +27,8 @@ TextureImporter::~TextureImporter()
 
 void TextureImporter::SaveTextureFile(Resource* resource)
 {
+	std::lock_guard<std::mutex> lock(devilMutex);
+
 	ILuint imageID;
 	ilGenImages(1, &imageID);
 	ilBindImage(imageID);
@@ -47,6 +55,12 @@ void TextureImporter::SaveTextureFile(Resource* resource)
 
 Texture* TextureImporter::LoadTextureImage(Resource* resource)
 {
+	// Without a GL context the texture stays registered but is never uploaded
+	if (app->IsHeadless())
+		return dynamic_cast<Texture*>(resource);
+
+	std::lock_guard<std::mutex> lock(devilMutex);
+
 	ILuint image;
 	ilGenImages(1, &image);
 	ilBindImage(image);
@@ -68,8 +82,10 @@ Texture* TextureImporter::LoadTextureImage(Resource* resource)
 	return newTexture;
 }
 
-GLuint TextureImporter::LoadIconImage(const std::string& filePath)
+bool TextureImporter::DecodeIconImage(const std::string& filePath, IconImage& image)
 {
+	std::lock_guard<std::mutex> lock(devilMutex);
+
 	ilClearColour(255, 255, 255, 255);
 
 	ILuint imageID;
@@ -79,24 +95,35 @@ GLuint TextureImporter::LoadIconImage(const std::string& filePath)
 	if (ilLoadImage(filePath.c_str()) == IL_FALSE)
 	{
 		ilDeleteImages(1, &imageID);
-		return 0;
+		return false;
 	}
 
 	ilConvertImage(IL_RGBA, IL_UNSIGNED_BYTE);
 
+	image.width = ilGetInteger(IL_IMAGE_WIDTH);
+	image.height = ilGetInteger(IL_IMAGE_HEIGHT);
+	image.pixels.assign(ilGetData(), ilGetData() + image.width * image.height * 4);
+
+	ilDeleteImages(1, &imageID);
+
+	return true;
+}
+
+GLuint TextureImporter::UploadIconImage(const IconImage& image)
+{
+	if (image.pixels.empty())
+		return 0;
+
 	GLuint textureID;
 	glGenTextures(1, &textureID);
 	glBindTexture(GL_TEXTURE_2D, textureID);
 
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, ilGetInteger(IL_IMAGE_WIDTH),
-		ilGetInteger(IL_IMAGE_HEIGHT), 0, GL_RGBA, GL_UNSIGNED_BYTE, ilGetData());
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, image.width, image.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, image.pixels.data());
 
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
-	ilDeleteImages(1, &imageID);
-
 	return textureID;
 }
\ No newline at end of file
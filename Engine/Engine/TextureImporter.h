@@ -4,6 +4,16 @@
 #include "Texture.h"
 
 #include <GL/glew.h>
+#include <string>
+#include <vector>
+
+// RGBA pixels decoded off the main thread, waiting for their GL upload
+struct IconImage
+{
+	int width = 0;
+	int height = 0;
+	std::vector<unsigned char> pixels;
+};
 
 class TextureImporter
 {
@@ -14,5 +24,6 @@ public:
 	void SaveTextureFile(Resource* resource);
 	Texture* LoadTextureImage(Resource* resource);
 
-	GLuint LoadIconImage(const std::string& filePath);
+	bool DecodeIconImage(const std::string& filePath, IconImage& image);
+	GLuint UploadIconImage(const IconImage& image);
 };
\ No newline at end of file
@@ -5,7 +5,8 @@
 
 Time::Time()
 	: gameTimer(new Timer()), realTimer(new Timer()), state(GameState::STOP),
-	frameCount(0), timeSinceStartup(0), timeScale(1.0f), deltaTime(0), realTimeSinceStartup(0), realDeltaTime(0), hasStarted(false)
+	frameCount(0), timeSinceStartup(0), timeScale(1.0f), deltaTime(0), realTimeSinceStartup(0), realDeltaTime(0),
+	fixedAccumulator(0), fixedStepCount(0), interpolationAlpha(1.0f), hasStarted(false)
 {
 }
 
@@ -20,29 +21,21 @@ void Time::Start()
 	gameTimer->Start();
 	realTimer->Start();
 
-	std::vector<GameObject*> objects;
-	app->scene->CollectObjects(app->scene->root, objects);
+	const ComponentSignature hasScript = SignatureOf(ComponentType::SCRIPT);
+	SceneRegistry& registry = app->scene->sceneRegistry;
 
-	for (const auto& object : objects)
-	{
-		if (object != nullptr)
+	registry.ForEach([](GameObject* object)
 		{
-			if (object->GetComponent(ComponentType::SCRIPT))
-			{
-				dynamic_cast<ComponentScript*>(object->GetComponent(ComponentType::SCRIPT))->Init();
-			}
-		}
-	}
-	for (const auto& object : objects)
-	{
-		if (object != nullptr && object->GetComponent(ComponentType::SCRIPT))
-			dynamic_cast<ComponentScript*>(object->GetComponent(ComponentType::SCRIPT))->Awake();
-	}
-	for (const auto& object : objects)
-	{
-		if (object != nullptr && object->GetComponent(ComponentType::SCRIPT))
-			dynamic_cast<ComponentScript*>(object->GetComponent(ComponentType::SCRIPT))->Start();
-	}
+			static_cast<ComponentScript*>(object->GetComponent(ComponentType::SCRIPT))->Init();
+		}, hasScript);
+	registry.ForEach([](GameObject* object)
+		{
+			static_cast<ComponentScript*>(object->GetComponent(ComponentType::SCRIPT))->Awake();
+		}, hasScript);
+	registry.ForEach([](GameObject* object)
+		{
+			static_cast<ComponentScript*>(object->GetComponent(ComponentType::SCRIPT))->Start();
+		}, hasScript);
 }
 
 void Time::Update()
@@ -51,23 +44,58 @@ void Time::Update()
 	{
 		deltaTime = 0;
 		realDeltaTime = 0;
+		fixedStepCount = 0;
+		interpolationAlpha = 1.0f;
 		return;
 	}
 
-	realDeltaTime = realTimer->ReadMs();
-	realTimeSinceStartup += realDeltaTime / 1000.0f;
+	realDeltaTime = realTimer->ReadNs();
+	realTimeSinceStartup += realDeltaTime;
 	realTimer->Reset();
 
 	if (state == GameState::PLAY || state == GameState::STEP)
 	{
-		deltaTime = realDeltaTime * timeScale;
-		timeSinceStartup += deltaTime / 1000.0f;
+		const int64_t frameTime = lockstep ? GetFixedStepNs() : realDeltaTime;
+		deltaTime = static_cast<int64_t>(frameTime * static_cast<double>(timeScale));
+		timeSinceStartup += deltaTime;
 		frameCount++;
 	}
 	else
 	{
 		deltaTime = 0;
 	}
+
+	UpdateFixedSteps();
+}
+
+void Time::UpdateFixedSteps()
+{
+	if (state == GameState::PAUSE)
+	{
+		fixedStepCount = 0;
+		return;
+	}
+
+	if (!fixedStep || state == GameState::STEP)
+	{
+		fixedStepCount = 1;
+		fixedAccumulator = 0;
+		interpolationAlpha = 1.0f;
+		return;
+	}
+
+	const int64_t fixedStepNs = GetFixedStepNs();
+
+	fixedAccumulator += deltaTime;
+	fixedStepCount = static_cast<int>(fixedAccumulator / fixedStepNs);
+	fixedAccumulator -= fixedStepCount * fixedStepNs;
+
+	// After a long hitch drop the time that cannot be caught up instead of
+	// spending the next frames simulating it
+	if (fixedStepCount > maxFixedSteps)
+		fixedStepCount = maxFixedSteps;
+
+	interpolationAlpha = static_cast<float>(fixedAccumulator) / fixedStepNs;
 }
 
 void Time::Play()
@@ -98,15 +126,15 @@ void Time::Stop()
 	timeSinceStartup = 0;
 	frameCount = 0;
 	realTimeSinceStartup = 0;
+	fixedAccumulator = 0;
+	fixedStepCount = 0;
+	interpolationAlpha = 1.0f;
 	hasStarted = false;
 
-	std::vector<GameObject*> objects;
-	app->scene->CollectObjects(app->scene->root, objects);
-	for (const auto& object : objects)
-	{
-		if (object != nullptr && object->GetComponent(ComponentType::SCRIPT))
-			dynamic_cast<ComponentScript*>(object->GetComponent(ComponentType::SCRIPT))->Reset();
-	}
+	app->scene->sceneRegistry.ForEach([](GameObject* object)
+		{
+			static_cast<ComponentScript*>(object->GetComponent(ComponentType::SCRIPT))->Reset();
+		}, SignatureOf(ComponentType::SCRIPT));
 }
 
 void Time::Step()
@@ -2,6 +2,8 @@
 
 #include "Timer.h"
 
+#include <cstdint>
+
 enum class GameState
 {
 	PLAY,
@@ -24,31 +26,56 @@ public:
 	void Stop();
 	void Step();
 
-	float GetDeltaTime() const { return deltaTime; }
-	float GetTimeSinceStartup() const { return timeSinceStartup; }
-	float GetRealDeltaTime() const { return realDeltaTime; }
-	float GetRealTimeSinceStartup() const { return realTimeSinceStartup; }
-	float GetFrameCount() const { return frameCount; }
+	// Deltas are in milliseconds and times in seconds, all derived from 64-bit nanosecond counters
+	float GetDeltaTime() const { return static_cast<float>(deltaTime / 1000000.0); }
+	float GetTimeSinceStartup() const { return static_cast<float>(timeSinceStartup / 1000000000.0); }
+	float GetRealDeltaTime() const { return static_cast<float>(realDeltaTime / 1000000.0); }
+	float GetRealTimeSinceStartup() const { return static_cast<float>(realTimeSinceStartup / 1000000000.0); }
+	uint64_t GetFrameCount() const { return frameCount; }
 	float GetTimeScale() const { return timeScale; }
 	GameState GetState() const { return state; }
 
+	int64_t GetDeltaTimeNs() const { return deltaTime; }
+	int64_t GetRealDeltaTimeNs() const { return realDeltaTime; }
+
+	// Fixed-step simulation
+	int64_t GetFixedStepNs() const { return static_cast<int64_t>(1000000000.0 / tickRate); }
+	float GetFixedDeltaTime() const { return fixedStep ? static_cast<float>(GetFixedStepNs() / 1000000.0) : GetDeltaTime(); }
+	int GetFixedStepCount() const { return fixedStepCount; }
+	float GetInterpolationAlpha() const { return interpolationAlpha; }
+
 	void SetTimeScale(float scale) { timeScale = scale; }
 	void SetState(GameState newState) { state = newState; }
 
 	bool IsPlaying() const { return hasStarted; }
 
+private:
+	void UpdateFixedSteps();
+
+public:
+	bool fixedStep = true;
+	float tickRate = 60.0f;
+	int maxFixedSteps = 5;
+
+	// Every frame advances exactly one tick whatever the wall clock says, so runs repeat
+	bool lockstep = false;
+
 private:
 	Timer* gameTimer;
 	Timer* realTimer;
 
 	GameState state;
 
-	float frameCount;
-	float timeSinceStartup;
+	uint64_t frameCount;
+	int64_t timeSinceStartup;
 	float timeScale;
-	float deltaTime;
-	float realTimeSinceStartup;
-	float realDeltaTime;
+	int64_t deltaTime;
+	int64_t realTimeSinceStartup;
+	int64_t realDeltaTime;
+
+	int64_t fixedAccumulator;
+	int fixedStepCount;
+	float interpolationAlpha;
 
 	bool hasStarted;
 };
@@ -1,5 +1,7 @@
 #include "Timer.h"
 
+#include <chrono>
+
 Timer::Timer()
 {
 	Start();
@@ -7,16 +9,25 @@ Timer::Timer()
 
 void Timer::Start()
 {
-	frequency = SDL_GetPerformanceFrequency();
-	startTime = SDL_GetPerformanceCounter();
+	startTime = NowNs();
 }
 
 float Timer::ReadMs() const
 {
-	return ((float)(SDL_GetPerformanceCounter() - startTime) / frequency * 1000.0f);
+	return static_cast<float>(ReadNs() / 1000000.0);
+}
+
+int64_t Timer::ReadNs() const
+{
+	return NowNs() - startTime;
 }
 
 void Timer::Reset()
 {
-	startTime = SDL_GetPerformanceCounter();
+	startTime = NowNs();
+}
+
+int64_t Timer::NowNs()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
 }
\ No newline at end of file
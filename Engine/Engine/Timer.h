@@ -1,6 +1,6 @@
 #pragma once
 
-#include "SDL2/SDL.h"
+#include <cstdint>
 
 class Timer
 {
@@ -9,9 +9,12 @@ public:
 
 	void Start();
 	float ReadMs() const;
+	int64_t ReadNs() const;
 	void Reset();
 
+	// Monotonic clock, never goes backwards and does not drift with long sessions
+	static int64_t NowNs();
+
 private:
-	Uint64 startTime;
-	Uint64 frequency;
+	int64_t startTime;
 };
\ No newline at end of file
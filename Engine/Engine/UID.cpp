@@ -0,0 +1,121 @@
+#include "UID.h"
+
+#include <random>
+
+namespace
+{
+	uint64_t SplitMix64(uint64_t& state)
+	{
+		uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+		return z ^ (z >> 31);
+	}
+
+	uint64_t RotateLeft(uint64_t value, int shift)
+	{
+		return (value << shift) | (value >> (64 - shift));
+	}
+
+	// xoshiro256**, seeded once per thread
+	class UIDGenerator
+	{
+	public:
+		UIDGenerator()
+		{
+			std::random_device rd;
+			uint64_t seed = (static_cast<uint64_t>(rd()) << 32) ^ rd();
+			for (uint64_t& s : state)
+				s = SplitMix64(seed);
+		}
+
+		uint64_t Next()
+		{
+			const uint64_t result = RotateLeft(state[1] * 5, 7) * 9;
+			const uint64_t t = state[1] << 17;
+
+			state[2] ^= state[0];
+			state[3] ^= state[1];
+			state[1] ^= state[2];
+			state[0] ^= state[3];
+			state[2] ^= t;
+			state[3] = RotateLeft(state[3], 45);
+
+			return result;
+		}
+
+	private:
+		uint64_t state[4];
+	};
+
+	int HexValue(char c)
+	{
+		if (c >= '0' && c <= '9') return c - '0';
+		if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+		if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+		return -1;
+	}
+}
+
+UID UID::Generate()
+{
+	thread_local UIDGenerator generator;
+
+	UID uid;
+	uid.high = generator.Next();
+	uid.low = generator.Next();
+
+	// Keep the version 4 / variant bits so the string form stays a valid UUID
+	uid.high = (uid.high & 0xFFFFFFFFFFFF0FFFull) | 0x0000000000004000ull;
+	uid.low = (uid.low & 0x3FFFFFFFFFFFFFFFull) | 0x8000000000000000ull;
+
+	return uid;
+}
+
+bool UID::FromString(const std::string& text, UID& uid)
+{
+	UID parsed;
+	int digits = 0;
+
+	for (char c : text)
+	{
+		if (c == '-')
+			continue;
+
+		const int value = HexValue(c);
+		if (value < 0 || digits >= 32)
+			return false;
+
+		if (digits < 16)
+			parsed.high = (parsed.high << 4) | static_cast<uint64_t>(value);
+		else
+			parsed.low = (parsed.low << 4) | static_cast<uint64_t>(value);
+
+		digits++;
+	}
+
+	if (digits != 32 || !parsed.IsValid())
+		return false;
+
+	uid = parsed;
+	return true;
+}
+
+std::string UID::ToString() const
+{
+	static const char* hex = "0123456789abcdef";
+
+	std::string text(36, '-');
+	int pos = 0;
+	for (int i = 0; i < 32; ++i)
+	{
+		if (pos == 8 || pos == 13 || pos == 18 || pos == 23)
+			pos++;
+
+		const uint64_t part = i < 16 ? high : low;
+		const int shift = (15 - (i % 16)) * 4;
+		text[pos++] = hex[(part >> shift) & 0xF];
+	}
+
+	return text;
+}
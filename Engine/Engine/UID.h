@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+// 128-bit identifier for scene objects. The string form is only used when
+// reading or writing scene files.
+struct UID
+{
+	uint64_t high = 0;
+	uint64_t low = 0;
+
+	static UID Generate();
+	// False for malformed text or the zero UID, uid is left untouched then
+	static bool FromString(const std::string& text, UID& uid);
+
+	std::string ToString() const;
+
+	bool IsValid() const { return high != 0 || low != 0; }
+
+	bool operator==(const UID& other) const { return high == other.high && low == other.low; }
+	bool operator!=(const UID& other) const { return !(*this == other); }
+};
+
+struct UIDHash
+{
+	size_t operator()(const UID& uid) const
+	{
+		return std::hash<uint64_t>()(uid.high ^ (uid.low * 0x9E3779B97F4A7C15ull));
+	}
+};